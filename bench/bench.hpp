@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <engine.hpp>
+#include <quickjs.hpp>
+
+namespace glint::bench {
+
+/// Engine with core and ecs plugins loaded and no window, shared by all benchmarks
+auto engine() -> Engine&;
+
+/// Evaluate module source and return its namespace
+auto eval_module(const std::string& name, const std::string& code) -> js::Object;
+
+/// Calls from JS into bound native functions
+auto calls() -> void;
+
+/// `convert_from_js`/`convert_to_js` for every supported type
+auto conversions() -> void;
+
+/// `JSClass::create_instance` for pooled and heap allocated classes
+auto classes() -> void;
+
+/// Calls from C++ into JS through `js::Function`
+auto functions() -> void;
+
+/// `ResourceStore` bookkeeping
+auto resource_store() -> void;
+
+/// `IFileStore::read_bytes`/`map` for directory and archive stores
+auto file_store() -> void;
+
+/// ECS spawn/despawn while typed array views of its columns are alive, detached and finalized
+auto ecs() -> void;
+
+} // namespace glint::bench
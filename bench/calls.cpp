@@ -0,0 +1,57 @@
+#include "./bench.hpp"
+
+#include <array>
+
+#include <nanobench.h>
+
+namespace glint::bench {
+
+namespace {
+
+constexpr auto calls_per_run = size_t {1000};
+
+constexpr auto source = R"js(
+import { Color, Vector2, graphics } from "@glint/core";
+
+const color = new Color(255, 0, 0);
+const a = new Vector2(1, 2);
+const b = new Vector2(3, 4);
+
+export function loop(n) {
+    for (let i = 0; i < n; i++);
+}
+
+export function circle(n) {
+    for (let i = 0; i < n; i++) graphics.circle(i, 10, 5.5, color);
+}
+
+export function vector2Add(n) {
+    for (let i = 0; i < n; i++) a.add(b);
+}
+
+export function vector2AddXY(n) {
+    for (let i = 0; i < n; i++) a.add(1.5, 2);
+}
+)js";
+
+} // namespace
+
+auto calls() -> void {
+    auto ns = eval_module("bench/calls.js", source);
+    const auto ctx = engine().js_context();
+    auto n = std::array {js::own(ctx, JS_NewInt32(ctx, int32_t(calls_per_run)))};
+
+    // Without a window graphics calls return right after unpacking arguments, so only binding cost is measured
+    auto bench = ankerl::nanobench::Bench {};
+    bench.title("JS -> native calls").unit("call").batch(calls_per_run).warmup(10).relative(true);
+    for (const auto name : {"loop", "circle", "vector2Add", "vector2AddXY"}) {
+        auto func = ns.at<js::Function>(name);
+        if (!func) throw std::runtime_error(func.error().msg());
+        bench.run(name, [&] {
+            auto r = (*func)(n);
+            if (!r) throw std::runtime_error(r.error().msg());
+        });
+    }
+}
+
+} // namespace glint::bench
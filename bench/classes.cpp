@@ -0,0 +1,67 @@
+#include "./bench.hpp"
+
+#include <array>
+
+#include <nanobench.h>
+
+#include <plugins/core/color.hpp>
+#include <plugins/core/profiler.hpp>
+#include <plugins/core/vector2.hpp>
+
+namespace glint::bench {
+
+namespace {
+
+using ankerl::nanobench::doNotOptimizeAway;
+
+constexpr auto source = R"js(
+let counter = 0;
+
+export function noArgs() {
+    counter++;
+}
+
+export function threeArgs(a, b, c) {
+    counter += a + b + c;
+}
+)js";
+
+} // namespace
+
+auto classes() -> void {
+    const auto ctx = engine().js_context();
+
+    // Objects are freed right away, so pooled classes keep reusing the same slab slot
+    auto bench = ankerl::nanobench::Bench {};
+    bench.title("JSClass::create_instance").unit("instance").warmup(100);
+    bench.run("Vector2 (pooled)", [&] {
+        JS_FreeValue(ctx, plugins::core::JSVector2::create_instance(ctx, 1.0f, 2.0f));
+    });
+    bench.run("Color (pooled)", [&] {
+        JS_FreeValue(ctx, plugins::core::JSColor::create_instance(ctx, 1, 2, 3, std::optional<unsigned char> {}));
+    });
+    bench.run("Profiler (heap)", [&] {
+        JS_FreeValue(ctx, plugins::core::JSProfiler::create_instance(ctx, &engine().profiler()));
+    });
+}
+
+auto functions() -> void {
+    const auto ctx = engine().js_context();
+    auto ns = eval_module("bench/function.js", source);
+    auto no_args = ns.at<js::Function>("noArgs");
+    if (!no_args) throw std::runtime_error(no_args.error().msg());
+    auto three_args = ns.at<js::Function>("threeArgs");
+    if (!three_args) throw std::runtime_error(three_args.error().msg());
+    auto args = std::array {
+        js::own(ctx, JS_NewInt32(ctx, 1)),
+        js::own(ctx, JS_NewInt32(ctx, 2)),
+        js::own(ctx, JS_NewInt32(ctx, 3)),
+    };
+
+    auto bench = ankerl::nanobench::Bench {};
+    bench.title("js::Function::operator()").unit("call").warmup(100);
+    bench.run("0 arguments", [&] { doNotOptimizeAway((*no_args)()); });
+    bench.run("3 arguments", [&] { doNotOptimizeAway((*three_args)(args)); });
+}
+
+} // namespace glint::bench
@@ -0,0 +1,81 @@
+#include "./bench.hpp"
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <nanobench.h>
+
+#include <plugins/core/vector2.hpp>
+
+namespace glint::bench {
+
+namespace {
+
+using ankerl::nanobench::doNotOptimizeAway;
+
+template<typename T>
+auto bench_from_js(ankerl::nanobench::Bench& bench, const char *name, const js::Value& val) -> void {
+    if (!js::convert_from_js<T>(val)) throw std::runtime_error(fmt::format("Could not convert {}", name));
+    bench.run(name, [&] { doNotOptimizeAway(js::convert_from_js<T>(val)); });
+}
+
+template<typename T>
+auto bench_to_js(ankerl::nanobench::Bench& bench, const char *name, const T& val) -> void {
+    const auto ctx = engine().js_context();
+    bench.run(name, [&] { doNotOptimizeAway(js::convert_to_js<T>(ctx, val)); });
+}
+
+constexpr auto source = R"js(
+export const values = {
+    bool: true,
+    int: 42,
+    float: 0.5,
+    string: "The quick brown fox jumps over the lazy dog",
+    object: { x: 1, y: 2 },
+    func: () => {},
+    array: [1, 2, 3, 4, 5, 6, 7, 8],
+    floats: new Float32Array(1024),
+};
+)js";
+
+} // namespace
+
+auto conversions() -> void {
+    const auto ctx = engine().js_context();
+    const auto ns = eval_module("bench/convert.js", source);
+    const auto values = ns.at<js::Object>("values");
+    if (!values) throw std::runtime_error(values.error().msg());
+    const auto value = [&](czstring name) -> js::Value {
+        return js::own(ctx, JS_GetPropertyStr(ctx, values->cget().cget(), name));
+    };
+
+    auto bench = ankerl::nanobench::Bench {};
+    bench.title("convert_from_js").unit("conversion").warmup(100);
+    bench_from_js<bool>(bench, "bool", value("bool"));
+    bench_from_js<double>(bench, "double (int tag)", value("int"));
+    bench_from_js<double>(bench, "double (float tag)", value("float"));
+    bench_from_js<int>(bench, "int (int tag)", value("int"));
+    bench_from_js<int>(bench, "int (float tag)", value("float"));
+    bench_from_js<float>(bench, "float", value("float"));
+    bench_from_js<std::string>(bench, "std::string", value("string"));
+    bench_from_js<js::Object>(bench, "Object", value("object"));
+    bench_from_js<js::Function>(bench, "Function", value("func"));
+    bench_from_js<std::vector<int>>(bench, "std::vector<int> (8 items)", value("array"));
+    bench_from_js<std::span<const float>>(bench, "std::span<const float>", value("floats"));
+    bench_from_js<std::optional<double>>(bench, "std::optional<double> (value)", value("float"));
+    bench_from_js<std::optional<double>>(bench, "std::optional<double> (undefined)", value("missing"));
+    bench_from_js<Vector2>(bench, "Vector2 (plain object)", value("object"));
+
+    bench = ankerl::nanobench::Bench {};
+    bench.title("convert_to_js").unit("conversion").warmup(100);
+    bench_to_js<bool>(bench, "bool", true);
+    bench_to_js<double>(bench, "double", 0.5);
+    bench_to_js<int>(bench, "int", 42);
+    bench_to_js<float>(bench, "float", 0.5f);
+    bench_to_js<std::string>(bench, "std::string", std::string("The quick brown fox jumps over the lazy dog"));
+    bench_to_js<js::Value>(bench, "Value", value("object"));
+}
+
+} // namespace glint::bench
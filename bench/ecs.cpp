@@ -0,0 +1,63 @@
+#include "./bench.hpp"
+
+#include <array>
+
+#include <nanobench.h>
+
+namespace glint::bench {
+
+namespace {
+
+constexpr auto churn_per_run = size_t {100};
+
+constexpr auto source = R"js(
+import { World } from "@glint/ecs";
+
+const world = new World();
+const Position = world.component("position", { x: "f32", y: "f32" });
+const Velocity = world.component("velocity", { x: "f32", y: "f32" });
+const moving = world.query([Position, Velocity]);
+for (let i = 0; i < 1000; i++) world.create([Position, Velocity]);
+
+let held = [];
+
+export function churn(n) {
+    for (let i = 0; i < n; i++) {
+        // Views read before a structural change are detached by it and finalized once dropped
+        held.push(moving.chunks[0].columns[0].x);
+        world.destroy(world.create([Position, Velocity]));
+        if (held.length > 64) held = [];
+    }
+}
+
+export function release() {
+    held = [];
+    return moving.count;
+}
+)js";
+
+} // namespace
+
+auto ecs() -> void {
+    auto ns = eval_module("bench/ecs.js", source);
+    const auto ctx = engine().js_context();
+    auto n = std::array {js::own(ctx, JS_NewInt32(ctx, int32_t(churn_per_run)))};
+
+    auto churn = ns.at<js::Function>("churn");
+    if (!churn) throw std::runtime_error(churn.error().msg());
+    auto bench = ankerl::nanobench::Bench {};
+    bench.title("ECS structural changes").unit("spawn/despawn").batch(churn_per_run).warmup(10);
+    bench.run("with live views", [&] {
+        auto r = (*churn)(n);
+        if (!r) throw std::runtime_error(r.error().msg());
+    });
+
+    // Runs finalizers of every view left, each after its buffer was already detached
+    auto release = ns.at<js::Function>("release");
+    if (!release) throw std::runtime_error(release.error().msg());
+    auto count = (*release)();
+    if (!count) throw std::runtime_error(count.error().msg());
+    JS_RunGC(engine().js_runtime());
+}
+
+} // namespace glint::bench
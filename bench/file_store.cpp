@@ -0,0 +1,83 @@
+#include "./bench.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <nanobench.h>
+#include <zip.h>
+
+#include <defer.hpp>
+#include <file_store.hpp>
+
+namespace glint::bench {
+
+namespace {
+
+using ankerl::nanobench::doNotOptimizeAway;
+
+struct Sample {
+    const char *name;
+    size_t size;
+};
+
+constexpr auto samples = std::array {
+    Sample {.name = "small.bin", .size = 4ul * 1024ul},
+    Sample {.name = "large.bin", .size = 1024ul * 1024ul},
+};
+
+/// Writes sample files to `dir` and packs them into `archive`, deflated and stored copies side by side
+auto prepare(const std::filesystem::path& dir, const std::filesystem::path& archive) -> void {
+    std::filesystem::create_directories(dir);
+    auto contents = std::vector<std::string> {};
+    for (const auto& sample : samples) {
+        auto& data = contents.emplace_back(sample.size, '\0');
+        for (auto i = size_t {0}; i < data.size(); i++) data[i] = char((i * 31) % 251);
+        auto file = std::ofstream(dir / sample.name, std::ios::binary);
+        file.write(data.data(), std::streamsize(data.size()));
+    }
+
+    auto ec = int {};
+    auto zip = zip_open(archive.string().c_str(), ZIP_CREATE | ZIP_TRUNCATE, &ec);
+    if (zip == nullptr) throw std::runtime_error("Could not create benchmark archive");
+    for (auto i = size_t {0}; i < samples.size(); i++) {
+        for (const auto method : {ZIP_CM_DEFLATE, ZIP_CM_STORE}) {
+            const auto name = fmt::format("{}/{}", method == ZIP_CM_STORE ? "stored" : "deflated", samples[i].name);
+            auto source = zip_source_buffer(zip, contents[i].data(), contents[i].size(), 0);
+            const auto index = zip_file_add(zip, name.c_str(), source, ZIP_FL_ENC_UTF_8);
+            if (index < 0) throw std::runtime_error(zip_strerror(zip));
+            zip_set_file_compression(zip, zip_uint64_t(index), method, 0);
+        }
+    }
+    if (zip_close(zip) < 0) throw std::runtime_error(zip_strerror(zip));
+}
+
+auto bench_store(ankerl::nanobench::Bench& bench, const char *store_name, IFileStore& store, const std::string& path)
+    -> void {
+    if (!store.read_bytes(path)) throw std::runtime_error(fmt::format("Could not read {}", path));
+    bench.run(fmt::format("{} read_bytes {}", store_name, path), [&] { doNotOptimizeAway(store.read_bytes(path)); });
+    bench.run(fmt::format("{} map {}", store_name, path), [&] { doNotOptimizeAway(store.map(path)); });
+}
+
+} // namespace
+
+auto file_store() -> void {
+    const auto dir = std::filesystem::temp_directory_path() / "glint-bench" / "files";
+    const auto archive = std::filesystem::temp_directory_path() / "glint-bench" / "files.zip";
+    prepare(dir, archive);
+
+    auto fs = FilesystemStore::open(dir);
+    if (!fs) throw std::runtime_error(fs.error()->msg());
+    auto zip = ZipStore::open(archive);
+    if (!zip) throw std::runtime_error(zip.error()->msg());
+
+    auto bench = ankerl::nanobench::Bench {};
+    bench.title("IFileStore").unit("read").warmup(10);
+    for (const auto& sample : samples) {
+        bench_store(bench, "FilesystemStore", *fs, sample.name);
+        bench_store(bench, "ZipStore", *zip, fmt::format("deflated/{}", sample.name));
+        bench_store(bench, "ZipStore", *zip, fmt::format("stored/{}", sample.name));
+    }
+}
+
+} // namespace glint::bench
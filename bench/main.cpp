@@ -0,0 +1,82 @@
+#include "./bench.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <defer.hpp>
+#include <plugins/core.hpp>
+#include <plugins/ecs.hpp>
+
+namespace glint::bench {
+
+auto engine() -> Engine& {
+    static auto engine = [] {
+        const auto dir = std::filesystem::temp_directory_path() / "glint-bench";
+        std::filesystem::create_directories(dir);
+
+        auto engine = Engine::create(dir);
+        if (!engine) throw std::runtime_error(engine.error()->msg());
+        (*engine)->register_plugin(plugins::core::plugin);
+        (*engine)->register_plugin(plugins::ecs::plugin);
+        if (auto r = (*engine)->load_plugins(); !r) throw std::runtime_error(r.error()->msg());
+        return std::move(*engine);
+    }();
+    return *engine;
+}
+
+auto eval_module(const std::string& name, const std::string& code) -> js::Object {
+    const auto ctx = engine().js_context();
+    const auto flags = JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY;
+    auto mod = JS_Eval(ctx, code.c_str(), code.size(), name.c_str(), flags);
+    if (JS_IsException(mod)) throw std::runtime_error(js::JSError(js::own(ctx, JS_GetException(ctx))).msg());
+
+    auto ret = JS_EvalFunction(ctx, mod);
+    defer(JS_FreeValue(ctx, ret));
+    for (auto job_ctx = static_cast<JSContext *>(nullptr); JS_ExecutePendingJob(JS_GetRuntime(ctx), &job_ctx) > 0;) {}
+    auto result = JS_PromiseResult(ctx, ret);
+    if (JS_IsError(result)) throw std::runtime_error(js::JSError(js::own(ctx, result)).msg());
+    JS_FreeValue(ctx, result);
+
+    auto ns = js::own(ctx, JS_GetModuleNamespace(ctx, static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(mod))));
+    return *js::Object::from_value(ns);
+}
+
+} // namespace glint::bench
+
+/// Usage: glint-bench [suite...], runs all suites when none given
+auto main(int argc, char **argv) -> int try {
+    spdlog::set_level(spdlog::level::warn);
+
+    const auto suites = std::array<std::pair<std::string_view, void (*)()>, 7> {{
+        {"calls", glint::bench::calls},
+        {"convert", glint::bench::conversions},
+        {"classes", glint::bench::classes},
+        {"functions", glint::bench::functions},
+        {"resource_store", glint::bench::resource_store},
+        {"file_store", glint::bench::file_store},
+        {"ecs", glint::bench::ecs},
+    }};
+
+    const auto args = std::span(argv, size_t(argc)).subspan(1);
+    for (const auto arg : args) {
+        if (std::ranges::find(suites, std::string_view(arg), &decltype(suites)::value_type::first) == suites.end()) {
+            fmt::println(stderr, "Unknown suite `{}`", arg);
+            return 1;
+        }
+    }
+    for (const auto& [name, run] : suites) {
+        if (args.empty() || std::ranges::find(args, name) != args.end()) run();
+    }
+
+    return 0;
+} catch (std::exception& e) {
+    fmt::println(stderr, "Benchmark failed: {}", e.what());
+    return 1;
+}
@@ -0,0 +1,53 @@
+#include "./bench.hpp"
+
+#include <nanobench.h>
+
+#include <resource_store.hpp>
+
+namespace glint::bench {
+
+namespace {
+
+using ankerl::nanobench::doNotOptimizeAway;
+
+/// Trivial resource, so only bookkeeping of the store is measured
+struct Data {
+    int value = 0;
+
+    using data_type = int;
+
+    auto get() noexcept -> int& { return value; }
+};
+
+} // namespace
+
+auto resource_store() -> void {
+    auto store = ResourceStore<Data> {};
+    // Keep some unrelated resources around so lookups do not hit a nearly empty table
+    for (auto i = 0; i < 256; i++) {
+        store.load(fmt::format("resource-{}", i), [=] { return Data {.value = i}; });
+    }
+    const auto handle = store.load("resource-0", [] { return Data {}; });
+
+    auto bench = ankerl::nanobench::Bench {};
+    bench.title("ResourceStore").unit("op").warmup(100);
+    bench.run("load (new) + release", [&] {
+        const auto h = store.load("fresh", [] { return Data {.value = 1}; });
+        store.release(h);
+    });
+    bench.run("load (cached) + release", [&] {
+        const auto h = store.load("resource-1", [] { return Data {}; });
+        store.release(h);
+    });
+    bench.run("load_by_name + release", [&] {
+        const auto h = store.load_by_name("resource-2");
+        store.release(h);
+    });
+    bench.run("get + release", [&] {
+        doNotOptimizeAway(store.get(handle));
+        store.release(handle);
+    });
+    bench.run("borrow", [&] { doNotOptimizeAway(store.borrow(handle)); });
+}
+
+} // namespace glint::bench
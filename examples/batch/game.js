@@ -0,0 +1,56 @@
+import { Color, graphics, keyboard, profiler, screen } from "@glint/core";
+
+export const config = {
+    window: {
+        title: "Batch",
+    },
+};
+
+const count = 10000;
+const bgColor = Color.fromHex("#181818");
+
+// Circles are packed as [x, y, radius] and velocities as [vx, vy]
+const circles = new Float32Array(count * 3);
+const velocities = new Float32Array(count * 2);
+const colors = new Uint8Array(count * 4);
+
+export function load() {
+    for (let i = 0; i < count; i++) {
+        circles[i * 3] = Math.random() * screen.width;
+        circles[i * 3 + 1] = Math.random() * screen.height;
+        circles[i * 3 + 2] = 2 + Math.random() * 4;
+
+        const angle = Math.random() * Math.PI * 2;
+        velocities[i * 2] = Math.cos(angle) * 200;
+        velocities[i * 2 + 1] = Math.sin(angle) * 200;
+
+        colors.set([randomByte(), randomByte(), randomByte(), 255], i * 4);
+    }
+}
+
+export function update() {
+    // F3 toggles the frame timing overlay
+    if (keyboard.isKeyPressed("f3")) profiler.overlay = !profiler.overlay;
+
+    const dt = screen.dt;
+    const width = screen.width;
+    const height = screen.height;
+
+    for (let i = 0; i < count; i++) {
+        const x = circles[i * 3] + velocities[i * 2] * dt;
+        const y = circles[i * 3 + 1] + velocities[i * 2 + 1] * dt;
+
+        if (x < 0 || x >= width) velocities[i * 2] *= -1;
+        else circles[i * 3] = x;
+
+        if (y < 0 || y >= height) velocities[i * 2 + 1] *= -1;
+        else circles[i * 3 + 1] = y;
+    }
+}
+
+export function draw() {
+    graphics.clear(bgColor);
+    graphics.circles(circles, colors);
+}
+
+const randomByte = () => Math.floor(Math.random() * 256);
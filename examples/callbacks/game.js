@@ -20,6 +20,14 @@ export const config = {
          */
         fps: 30,
     },
+
+    loop: {
+        /**
+         * Optional fixed rate for `fixedUpdate`, independent of `fps`. Engine
+         * runs as many fixed updates per frame as needed to keep up.
+         */
+        fixedUpdateHz: 60,
+    },
 };
 
 /**
@@ -38,6 +46,14 @@ export function update() {
     console.log("My game is updating");
 }
 
+/**
+ * Engine will call this `config.loop.fixedUpdateHz` times per second, before
+ * `update`. Use for physics and other logic that needs a constant time step
+ */
+export function fixedUpdate() {
+    console.log("My game is updating at fixed rate");
+}
+
 /**
  * Engine will call this every frame. Use to render your game on the screen
  */
@@ -46,14 +62,17 @@ export function draw() {
 }
 
 /**
- * Engine will call this function if you press F5.
+ * Engine will call this function if you press F5 or save a module your game
+ * loaded.
  *
- * After that, engine will try to load your game again. If it's successful,
- * engine will call postReload on new game. If it's successful too, then old
- * game will be replaced with the new game.
+ * After that, engine will load your game again in a fresh context. If it's
+ * successful, the old game is replaced with the new one and engine calls
+ * postReload on it. If loading fails, the old game keeps running. If
+ * postReload fails, the new game keeps running without the old state.
  *
- * You can return arbitary value from this function and it will be passed to
- * postReload function if present.
+ * Value you return is copied over to postReload, so it may hold primitives,
+ * plain objects, arrays and typed arrays, but not functions or engine objects.
+ * If it can't be copied, postReload is called without it.
  *
  * @returns {string}
  */
@@ -63,8 +82,8 @@ export function preReload() {
 }
 
 /**
- * Data returned from preReload will be passed here. You could reinitialize
- * your game using it.
+ * Copy of data returned from preReload of the old game will be passed here.
+ * You could reinitialize your game using it.
  *
  * @param {string} data
  */
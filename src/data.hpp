@@ -18,25 +18,33 @@ struct TextureData {
     auto get() noexcept -> rl::Texture& { return texture; }
 
     static auto load(const std::filesystem::path& name, IFileStore& file_store) noexcept -> TextureData try {
-        auto buf = file_store.read_bytes(name);
-        if (!buf) {
-            SPDLOG_WARN("Could not load texture {}: {}", name.string(), buf.error()->msg());
+        auto file = file_store.map(name);
+        if (!file) {
+            SPDLOG_WARN("Could not load texture {}: {}", name.string(), file.error()->msg());
             return {};
         }
 
-        return load_from_memory(name, *buf);
+        return load_from_memory(name, file->bytes());
     } catch (...) {
         return {};
     }
 
-    static auto load_from_memory(const std::filesystem::path& name, std::span<char> buf) noexcept -> TextureData try {
-        // NOLINTNEXTLINE: cast from unsigned char* to char* is safe
-        const auto data = std::span(reinterpret_cast<unsigned char *>(buf.data()), int(buf.size()));
+    static auto load_from_memory(const std::filesystem::path& name, std::span<const char> buf) noexcept
+        -> TextureData try {
+        // NOLINTNEXTLINE: cast from char* to unsigned char* is safe
+        const auto data = std::span(reinterpret_cast<const unsigned char *>(buf.data()), buf.size());
         auto texture = rl::Texture::load_from_memory(name.extension().string().c_str(), data);
         return {.texture = std::move(texture), .name = name};
     } catch (...) {
         return {};
     }
+
+    /// Uploads image decoded off the main thread
+    static auto from_image(const std::filesystem::path& name, const ::Image& image) noexcept -> TextureData try {
+        return {.texture = rl::Texture::load_from_image(image), .name = name};
+    } catch (...) {
+        return {};
+    }
 };
 
 struct FontData {
@@ -53,25 +61,25 @@ struct FontData {
         std::optional<std::span<int>> codepoints,
         IFileStore& file_store
     ) noexcept -> FontData try {
-        auto buf = file_store.read_bytes(name);
-        if (!buf) {
-            SPDLOG_WARN("Could not load font {}: {}", name.string(), buf.error()->msg());
+        auto file = file_store.map(name);
+        if (!file) {
+            SPDLOG_WARN("Could not load font {}: {}", name.string(), file.error()->msg());
             return {};
         }
 
-        return load_from_memory(name, *buf, font_size, codepoints);
+        return load_from_memory(name, file->bytes(), font_size, codepoints);
     } catch (...) {
         return {};
     }
 
     static auto load_from_memory(
         const std::filesystem::path& name,
-        std::span<char> buf,
+        std::span<const char> buf,
         int font_size,
         std::optional<std::span<int>> codepoints
     ) noexcept -> FontData try {
-        // NOLINTNEXTLINE: cast from unsigned char* to char* is safe
-        auto data = std::span(reinterpret_cast<unsigned char *>(buf.data()), int(buf.size()));
+        // NOLINTNEXTLINE: cast from char* to unsigned char* is safe
+        auto data = std::span(reinterpret_cast<const unsigned char *>(buf.data()), buf.size());
         auto font = rl::Font::load_from_memory(name.extension().string().c_str(), data, font_size, codepoints);
         return {.font = std::move(font), .name = name};
     } catch (...) {
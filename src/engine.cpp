@@ -3,13 +3,17 @@
 #include <spdlog/spdlog.h>
 #include <raylib.h>
 
+#include <chrono>
+#include <utility>
+
 #include <defer.hpp>
 #include <engine/window.hpp>
 #include <glint_config.h>
-#include <utility>
 
 namespace glint {
 
+extern "C" auto module_normalize(JSContext *ctx, const char *base_name, const char *module_name, void *opaque) noexcept
+    -> char *;
 extern "C" auto module_loader(JSContext *ctx, const char *module_name, void *opaque) noexcept -> JSModuleDef *;
 auto read_config(js::Object& ns) -> Result<GameConfig>;
 
@@ -23,6 +27,15 @@ auto Engine::JSContext_deleter::operator()(JSContext *ctx) noexcept -> void {
     JS_FreeContext(ctx);
 }
 
+Engine::ShutdownCallbacks::~ShutdownCallbacks() {
+    SPDLOG_TRACE("Shutting down plugins");
+    for (const auto& callback : callbacks) {
+        if (auto result = callback(); !result) {
+            SPDLOG_WARN("Error shutting down plugin: {}", result.error()->msg());
+        }
+    }
+}
+
 auto Engine::create(const std::filesystem::path& base_path) noexcept -> Result<std::unique_ptr<Engine>> {
     window::setup();
 
@@ -55,9 +68,19 @@ auto Engine::create(const std::filesystem::path& base_path) noexcept -> Result<s
     if (engine_ptr == nullptr) return err("Could not allocate engine");
     auto engine = std::unique_ptr<Engine>(engine_ptr);
 
+    if (std::filesystem::is_directory(base_path)) {
+        engine->_bytecode_cache = engine::bytecode::Cache {.dir = base_path / ".glint" / "bytecode"};
+        SPDLOG_DEBUG("Using bytecode cache at {}", engine->_bytecode_cache->dir.string());
+        if (auto r = engine::watcher::open(engine->_watcher, base_path); !r) {
+            SPDLOG_WARN("Modules will not be reloaded on change: {}", r.error()->msg());
+        }
+    }
+    // Game module is compiled directly by `Game::create`, but changes to it must still trigger reload
+    engine::modules::add(engine->_modules, "game.js");
+
     JS_SetDumpFlags(engine->js_runtime(), JS_DUMP_LEAKS);
     JS_SetRuntimeOpaque(engine->js_runtime(), engine.get());
-    JS_SetModuleLoaderFunc(engine->js_runtime(), nullptr, module_loader, engine.get());
+    JS_SetModuleLoaderFunc(engine->js_runtime(), module_normalize, module_loader, engine.get());
 
     SPDLOG_TRACE("Engine created successfully");
     return engine;
@@ -91,7 +114,36 @@ auto Engine::font_store() noexcept -> ResourceStore<FontData>& {
     return _font_store;
 }
 
-auto Engine::register_plugin(const plugins::EnginePlugin& desc) noexcept -> void try {
+auto Engine::atlas() noexcept -> engine::atlas::Atlas& {
+    return _atlas;
+}
+
+auto Engine::profiler() noexcept -> engine::profiler::Profiler& {
+    return _profiler;
+}
+
+auto Engine::timestep() const noexcept -> const engine::timestep::Timestep& {
+    return _timestep;
+}
+
+auto Engine::loader() noexcept -> engine::loader::Loader& {
+    return _loader;
+}
+
+auto Engine::game_window() const noexcept -> window::Window * {
+    return _window;
+}
+
+auto Engine::register_plugin(plugins::PluginFactory factory) noexcept -> void try {
+    auto desc = factory(js_context());
+    add_plugin(desc);
+    _plugin_factories.push_back(std::move(factory));
+    SPDLOG_INFO("Registered `{}` plugin", desc.name);
+} catch (...) {
+    std::terminate();
+}
+
+auto Engine::add_plugin(const plugins::EnginePlugin& desc) -> void {
     for (const auto& [name, module] : desc.c_modules) {
         // TODO: check if already exists
         _c_modules.insert({name, module});
@@ -110,17 +162,21 @@ auto Engine::register_plugin(const plugins::EnginePlugin& desc) noexcept -> void
         _unload_callbacks.emplace_back(desc.unload);
     }
 
+    if (desc.shutdown != nullptr) {
+        _shutdown.callbacks.emplace_back(desc.shutdown);
+    }
+
     if (desc.update != nullptr) {
-        _update_callbacks.emplace_back(desc.update);
+        _update_callbacks.push_back({.plugin = desc.name, .callback = desc.update});
     }
 
     if (desc.draw != nullptr) {
-        _draw_callbacks.emplace_back(desc.draw);
+        _draw_callbacks.push_back({.plugin = desc.name, .callback = desc.draw});
     }
 
-    SPDLOG_INFO("Registered `{}` plugin", desc.name);
-} catch (...) {
-    std::terminate();
+    if (desc.post_draw != nullptr) {
+        _post_draw_callbacks.push_back({.plugin = desc.name, .callback = desc.post_draw});
+    }
 }
 
 auto Engine::load_plugins() noexcept -> Result<> try {
@@ -133,15 +189,17 @@ auto Engine::load_plugins() noexcept -> Result<> try {
     return err(e);
 }
 
-[[nodiscard]] auto Engine::run_game(Game& game) noexcept -> Result<> try {
-    defer({
-        SPDLOG_TRACE("Unloading plugins");
-        for (const auto& callback : _unload_callbacks) {
-            if (auto result = callback(); !result) {
-                SPDLOG_WARN("Error unloading plugin: {}", result.error()->msg());
-            }
+auto Engine::unload_plugins() noexcept -> void {
+    SPDLOG_TRACE("Unloading plugins");
+    for (const auto& callback : _unload_callbacks) {
+        if (auto result = callback(); !result) {
+            SPDLOG_WARN("Error unloading plugin: {}", result.error()->msg());
         }
-    });
+    }
+}
+
+[[nodiscard]] auto Engine::run_game(Game& game, const RunOptions& options) noexcept -> Result<> try {
+    defer(unload_plugins());
 
     SPDLOG_DEBUG("Creating window");
     auto w = window::create(
@@ -165,96 +223,323 @@ auto Engine::load_plugins() noexcept -> Result<> try {
                 | (game.config().window.mouse_passthrough ? FLAG_WINDOW_MOUSE_PASSTHROUGH : 0)
                 | (game.config().window.borderless_windowed_mode ? FLAG_BORDERLESS_WINDOWED_MODE : 0)
                 | (game.config().window.msaa_4x_hint ? FLAG_MSAA_4X_HINT : 0)
-                | (game.config().window.interlaced_hint ? FLAG_INTERLACED_HINT : 0)
+                | (game.config().window.interlaced_hint ? FLAG_INTERLACED_HINT : 0),
+            .headless = options.headless,
         }
     );
+    _window = &w;
     defer({
         SPDLOG_TRACE("Closing window");
+        _window = nullptr;
+        // Atlas pages are GPU textures, so references held by atlas go before the window does
+        engine::atlas::clear(_atlas, _texture_store);
         window::close(w);
     });
 
+    apply_config(game.config());
+
     SPDLOG_DEBUG("Loading game");
     if (auto r = game.load(); !r) return err(r);
 
-    SPDLOG_DEBUG("Running rame");
-    while (!window::should_close(w)) {
-        if (IsKeyPressed(KEY_F5)) {
-            if (auto r = game.try_reload(); !r) {
+    namespace profiler = engine::profiler;
+    const auto frame_track = profiler::track(_profiler, "frame");
+    const auto loader_track = profiler::track(_profiler, "loader");
+    auto update_tracks = std::vector<size_t> {};
+    for (const auto& plugin : _update_callbacks) {
+        update_tracks.push_back(profiler::track(_profiler, fmt::format("update:{}", plugin.plugin)));
+    }
+    const auto game_fixed_update_track = profiler::track(_profiler, "fixedUpdate:game");
+    const auto game_update_track = profiler::track(_profiler, "update:game");
+    auto draw_tracks = std::vector<size_t> {};
+    for (const auto& plugin : _draw_callbacks) {
+        draw_tracks.push_back(profiler::track(_profiler, fmt::format("draw:{}", plugin.plugin)));
+    }
+    const auto game_draw_track = profiler::track(_profiler, "draw:game");
+    auto post_draw_tracks = std::vector<size_t> {};
+    for (const auto& plugin : _post_draw_callbacks) {
+        post_draw_tracks.push_back(profiler::track(_profiler, fmt::format("post_draw:{}", plugin.plugin)));
+    }
+    const auto present_track = profiler::track(_profiler, "present");
+
+    SPDLOG_DEBUG("Running game");
+    const auto start = std::chrono::steady_clock::now();
+    auto frame = uint64_t {0};
+    for (; !window::should_close(w) && (!options.frames || frame < *options.frames); frame++) {
+        const auto frame_start = profiler::Clock::now();
+        if (poll_changed_modules() || IsKeyPressed(KEY_F5)) {
+            if (auto r = reload_game(game); !r) {
                 SPDLOG_ERROR("Exception occured while reloading the game: {}", r.error()->msg());
             }
         }
 
+        SPDLOG_TRACE("Finishing loaded assets");
+        {
+            const auto scope = profiler::Scope(_profiler, loader_track);
+            engine::loader::poll(_loader);
+            run_pending_jobs();
+        }
+
         SPDLOG_TRACE("Updating plugins");
-        for (const auto& callback : _update_callbacks) {
-            if (auto r = callback(); !r) return err(r);
+        for (size_t i = 0; i < _update_callbacks.size(); i++) {
+            const auto scope = profiler::Scope(_profiler, update_tracks[i]);
+            if (auto r = _update_callbacks[i].callback(); !r) return err(r);
+        }
+
+        if (const auto steps = engine::timestep::advance(_timestep, window::frame_time(w)); steps > 0) {
+            SPDLOG_TRACE("Running {} fixed updates", steps);
+            const auto scope = profiler::Scope(_profiler, game_fixed_update_track);
+            _timestep.in_fixed_update = true;
+            defer(_timestep.in_fixed_update = false);
+            for (auto i = 0; i < steps; i++) {
+                if (auto r = game.fixed_update(); !r) return err(r);
+            }
         }
 
         SPDLOG_TRACE("Updating game");
-        if (auto r = game.update(); !r) return err(r);
+        {
+            const auto scope = profiler::Scope(_profiler, game_update_track);
+            if (auto r = game.update(); !r) return err(r);
+        }
 
         window::begin_drawing(w);
 
         SPDLOG_TRACE("Drawing plugins");
-        for (const auto& callback : _draw_callbacks) {
-            if (auto r = callback(); !r) return err(r);
+        for (size_t i = 0; i < _draw_callbacks.size(); i++) {
+            const auto scope = profiler::Scope(_profiler, draw_tracks[i]);
+            if (auto r = _draw_callbacks[i].callback(); !r) return err(r);
         }
 
         SPDLOG_TRACE("Drawing game");
-        if (auto r = game.draw(); !r) return err(r);
+        {
+            const auto scope = profiler::Scope(_profiler, game_draw_track);
+            if (auto r = game.draw(); !r) return err(r);
+        }
+
+        SPDLOG_TRACE("Finishing plugin drawing");
+        for (size_t i = 0; i < _post_draw_callbacks.size(); i++) {
+            const auto scope = profiler::Scope(_profiler, post_draw_tracks[i]);
+            if (auto r = _post_draw_callbacks[i].callback(); !r) return err(r);
+        }
 
         window::draw_fps(w);
+        profiler::draw_overlay(_profiler);
+
+        if (!options.headless) {
+            const auto version_text = fmt::format("glint v{} ({})", GLINT_VERSION_STRING, GLINT_GIT_HASH_SHORT);
+            const auto font_size = 10;
+            const auto version_width = MeasureText(version_text.c_str(), font_size);
+            const auto version_outline_rect_padding = 3;
+            DrawRectangle(
+                10 - version_outline_rect_padding,
+                GetScreenHeight() - version_outline_rect_padding - 10 - font_size,
+                version_width + version_outline_rect_padding * 2,
+                font_size + version_outline_rect_padding * 2,
+                ColorAlpha(GRAY, 0.2f)
+            );
+            DrawText(version_text.c_str(), 10, GetScreenHeight() - 10 - font_size, font_size, ColorAlpha(WHITE, 0.4f));
+        }
+
+        {
+            // Includes buffer swap, input polling and the frame limiter wait
+            const auto scope = profiler::Scope(_profiler, present_track);
+            window::end_drawing(w);
+        }
+
+        if (_profiler.enabled) profiler::record(_profiler, frame_track, profiler::Clock::now() - frame_start);
+        profiler::end_frame(_profiler);
+    }
 
-        const auto version_text = fmt::format("glint v{} ({})", GLINT_VERSION_STRING, GLINT_GIT_HASH_SHORT);
-        const auto font_size = 10;
-        const auto version_width = MeasureText(version_text.c_str(), font_size);
-        const auto version_outline_rect_padding = 3;
-        DrawRectangle(
-            10 - version_outline_rect_padding,
-            GetScreenHeight() - version_outline_rect_padding - 10 - font_size,
-            version_width + version_outline_rect_padding * 2,
-            font_size + version_outline_rect_padding * 2,
-            ColorAlpha(GRAY, 0.2f)
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    SPDLOG_INFO(
+        "Ran {} frames in {:.2f}ms ({:.3f}ms per frame)",
+        frame,
+        elapsed.count(),
+        frame > 0 ? elapsed.count() / double(frame) : 0.0
+    );
+    for (const auto& track : _profiler.tracks) {
+        const auto s = profiler::stats(_profiler, track);
+        SPDLOG_DEBUG(
+            "{}: p50 {:.3f}ms, p95 {:.3f}ms, p99 {:.3f}ms, max {:.3f}ms",
+            track.name,
+            s.p50,
+            s.p95,
+            s.p99,
+            s.max
         );
-        DrawText(version_text.c_str(), 10, GetScreenHeight() - 10 - font_size, font_size, ColorAlpha(WHITE, 0.4f));
+    }
+
+    return {};
+} catch (std::exception& e) {
+    return err(e);
+}
 
-        window::end_drawing(w);
+auto Engine::reload_game(Game& game) noexcept -> Result<> try {
+    SPDLOG_TRACE("Reloading game");
+    const auto start = std::chrono::steady_clock::now();
+    const auto heap_before = heap_size();
+
+    // State that cannot be serialized must not keep the game from ever reloading, so it is dropped instead.
+    // Error holds a value of previous context, so it goes out of scope before the context is freed
+    if (auto state = game.save_state(); !state) {
+        SPDLOG_ERROR("Game will reload without previous state: {}", state.error()->msg());
+    } else if (*state) {
+        _reload_state = std::move(*state);
+    }
+
+    auto context_ptr = JS_NewContext(js_runtime());
+    if (context_ptr == nullptr) return err("Could not allocate context");
+
+    // New game packs its atlas again, pages still used by textures of previous game stay alive with them
+    engine::atlas::clear(_atlas, _texture_store);
+
+    // Previous game is set aside rather than torn down, so that it keeps running if the new one fails to load
+    SPDLOG_TRACE("Creating plugins for new context");
+    auto previous = ContextState {.loader_generation = _loader.generation + 1};
+    swap_context_state(previous);
+    auto previous_context = std::optional(std::move(_js_context));
+    _js_context = std::unique_ptr<JSContext, JSContext_deleter>(context_ptr);
+
+    auto new_game = [&]() -> Result<Game> {
+        for (const auto& factory : _plugin_factories) {
+            add_plugin(factory(js_context()));
+        }
+        if (auto r = load_plugins(); !r) return err(r);
+        engine::modules::add(_modules, "game.js");
+        return Game::create(js_context(), &file_store());
+    }();
+
+    if (!new_game) {
+        SPDLOG_TRACE("Freeing context of game that failed to load");
+        // Error may hold a value of the failed context, so only its message outlives it
+        const auto message = new_game.error()->msg();
+        new_game = err(message);
+        _reload_state.reset();
+        swap_context_state(previous);
+        auto failed_context = std::optional(std::move(_js_context));
+        _js_context = std::move(*previous_context);
+        previous_context.reset();
+        // Queued jobs keep their context alive, so they are run rather than left behind
+        run_pending_jobs();
+        release_context_state(previous);
+        failed_context.reset();
+        JS_RunGC(js_runtime());
+        return err(message);
     }
 
+    auto restored = _reload_state ? new_game->restore_state(*_reload_state) : new_game->restore_state(std::nullopt);
+    if (!restored) SPDLOG_ERROR("Game reloaded without previous state: {}", restored.error()->msg());
+    _reload_state.reset();
+
+    const auto heap_both = heap_size();
+    SPDLOG_TRACE("Freeing previous context");
+    // Everything holding values of previous context must let go of them before it is freed
+    game = std::move(*new_game);
+    apply_config(game.config());
+    run_pending_jobs();
+    release_context_state(previous);
+    previous_context.reset();
+    // Module records and closures reference each other, so only a full collection frees them
+    JS_RunGC(js_runtime());
+
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    SPDLOG_INFO(
+        "Reloaded game in {:.1f}ms, JS heap {} KiB before, {} KiB with both games loaded, {} KiB after",
+        elapsed.count(),
+        heap_before / 1024,
+        heap_both / 1024,
+        heap_size() / 1024
+    );
     return {};
 } catch (std::exception& e) {
     return err(e);
 }
 
-auto Engine::load_module(const std::filesystem::path& name) noexcept -> Result<owner<JSModuleDef *>> try {
-    if (auto cm = _c_modules.find(name); cm != _c_modules.end()) {
-        SPDLOG_DEBUG("Module {} resolved as builtin native module", name.string());
+auto Engine::apply_config(const GameConfig& config) noexcept -> void {
+    _loader.uploads_per_frame = std::max(config.loader.uploads_per_frame, 1);
+    engine::timestep::configure(_timestep, config.loop.fixed_update_hz, config.loop.max_fixed_updates);
+}
+
+auto Engine::swap_context_state(ContextState& state) noexcept -> void {
+    std::swap(_js_modules, state.js_modules);
+    std::swap(_c_modules, state.c_modules);
+    std::swap(_load_callbacks, state.load_callbacks);
+    std::swap(_unload_callbacks, state.unload_callbacks);
+    std::swap(_shutdown.callbacks, state.shutdown_callbacks);
+    std::swap(_update_callbacks, state.update_callbacks);
+    std::swap(_draw_callbacks, state.draw_callbacks);
+    std::swap(_post_draw_callbacks, state.post_draw_callbacks);
+    std::swap(_modules, state.modules);
+    std::swap(_loader.generation, state.loader_generation);
+}
+
+auto Engine::release_context_state(ContextState& state) noexcept -> void {
+    engine::loader::cancel(_loader, state.loader_generation);
+    for (const auto& callback : state.unload_callbacks) {
+        if (auto result = callback(); !result) {
+            SPDLOG_WARN("Error unloading plugin: {}", result.error()->msg());
+        }
+    }
+    state = ContextState {};
+}
+
+auto Engine::heap_size() const noexcept -> int64_t {
+    auto usage = JSMemoryUsage {};
+    JS_ComputeMemoryUsage(js_runtime(), &usage);
+    return usage.malloc_size;
+}
+
+auto Engine::run_pending_jobs() noexcept -> void {
+    for (;;) {
+        auto ctx = static_cast<JSContext *>(nullptr);
+        const auto r = JS_ExecutePendingJob(js_runtime(), &ctx);
+        if (r == 0) return;
+        if (r < 0) {
+            auto e = js::JSError(js::own(ctx, JS_GetException(ctx)));
+            SPDLOG_ERROR("Unhandled exception in promise job: {}", e.msg());
+        }
+    }
+}
+
+auto Engine::poll_changed_modules() -> bool {
+    const auto files = engine::watcher::poll(_watcher);
+    if (files.empty()) return false;
+
+    auto paths = std::vector<std::string> {};
+    for (const auto& file : files) {
+        paths.push_back(file.generic_string());
+    }
+    const auto count = engine::modules::affected(_modules, paths);
+    if (count == 0) return false;
+    SPDLOG_INFO("{} file(s) changed, reloading game ({} module(s) affected)", files.size(), count);
+    return true;
+}
+
+auto Engine::resolve_module(std::string_view base, std::string_view name) -> std::string {
+    auto path = engine::modules::resolve(base, name);
+    if (_c_modules.contains(path) || _js_modules.contains(path)) return path;
+    path = engine::modules::normalize(std::move(path));
+    engine::modules::add(_modules, path, base);
+    return path;
+}
+
+auto Engine::load_module(const std::string& name) noexcept -> Result<owner<JSModuleDef *>> try {
+    const auto path = std::filesystem::path(name);
+    if (auto cm = _c_modules.find(path); cm != _c_modules.end()) {
+        SPDLOG_DEBUG("Module {} resolved as builtin native module", name);
         return cm->second;
     } else {
-        auto code = std::string {};
-        if (auto jm = _js_modules.find(name); jm != _js_modules.end()) {
-            SPDLOG_DEBUG("Module {} resolved as builtin js module", name.string());
-            code = jm->second;
+        JSValue ret = JS_UNDEFINED;
+        if (auto jm = _js_modules.find(path); jm != _js_modules.end()) {
+            SPDLOG_DEBUG("Module {} resolved as builtin js module", name);
+            ret = compile_module(name, jm->second);
         } else {
-            auto path = name;
-            // TODO: error handling
-            if (!path.has_extension()) {
-                path += ".js";
-            }
             SPDLOG_TRACE("Loading module {}", path.string());
-            const auto contents = _file_store->read_string(path);
-            if (!contents) return err(contents);
-            SPDLOG_DEBUG("Module {} resolved as game module", name.string());
-            code = *contents;
+            auto compiled = compile_file(path, name);
+            if (!compiled) return err(compiled);
+            SPDLOG_DEBUG("Module {} resolved as game module", name);
+            ret = *compiled;
         }
 
-        JSValue ret = JS_Eval(
-            js_context(),
-            code.c_str(),
-            code.size(),
-            name.string().c_str(),
-            JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY
-        );
-
         if (JS_IsException(ret)) return static_cast<JSModuleDef *>(nullptr);
         auto mod = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(ret));
         JS_FreeValue(js_context(), ret);
@@ -265,6 +550,18 @@ auto Engine::load_module(const std::filesystem::path& name) noexcept -> Result<o
     return err(e);
 }
 
+auto Engine::compile_module(const std::string& name, const std::string& code) noexcept -> JSValue {
+    return engine::bytecode::compile_module(js_context(), nullptr, name, code);
+}
+
+auto Engine::compile_file(const std::filesystem::path& path, const std::string& name) noexcept -> Result<JSValue> {
+    return engine::bytecode::compile_file(js_context(), *_file_store, bytecode_cache(), path, name);
+}
+
+auto Engine::bytecode_cache() const noexcept -> const engine::bytecode::Cache * {
+    return _bytecode_cache ? &*_bytecode_cache : nullptr;
+}
+
 Engine::Engine(
     std::unique_ptr<JSRuntime, JSRuntime_deleter>&& runtime,
     std::unique_ptr<JSContext, JSContext_deleter>&& context,
@@ -277,18 +574,10 @@ Engine::Engine(
 auto Game::create(not_null<JSContext *> js, not_null<IFileStore *> store) -> Result<Game> {
     SPDLOG_TRACE("Creating game");
 
-    SPDLOG_TRACE("Reading game file");
-    const auto src = store->read_string("game.js");
-    if (!src) return err(src);
-
     SPDLOG_TRACE("Compiling game module");
-    auto mod = JS_Eval(
-        js,
-        src->c_str(),
-        src->size(),
-        "game.js",
-        JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_STRICT | JS_EVAL_FLAG_COMPILE_ONLY
-    );
+    auto mod_result = Engine::get(js).compile_file("game.js", "game.js");
+    if (!mod_result) return err(mod_result);
+    auto mod = *mod_result;
     if (JS_HasException(js)) return err(js::JSError(js::own(js, JS_GetException(js))));
 
     SPDLOG_TRACE("Evaluating game module");
@@ -312,6 +601,8 @@ auto Game::create(not_null<JSContext *> js, not_null<IFileStore *> store) -> Res
     if (!load) return err("game.load is not a function");
     auto update = ns.at<std::optional<js::Function>>("update");
     if (!update) return err("game.update is not a function");
+    auto fixed_update = ns.at<std::optional<js::Function>>("fixedUpdate");
+    if (!fixed_update) return err("game.fixedUpdate is not a function");
     auto draw = ns.at<std::optional<js::Function>>("draw");
     if (!draw) return err("game.draw is not a function");
     auto pre_reload = ns.at<std::optional<js::Function>>("preReload");
@@ -326,6 +617,7 @@ auto Game::create(not_null<JSContext *> js, not_null<IFileStore *> store) -> Res
         .config = *config,
         .load = std::move(*load),
         .update = std::move(*update),
+        .fixed_update = std::move(*fixed_update),
         .draw = std::move(*draw),
         .pre_reload = std::move(*pre_reload),
         .post_reload = std::move(*post_reload),
@@ -351,6 +643,13 @@ auto Game::update() noexcept -> Result<> {
     return {};
 }
 
+[[nodiscard]]
+auto Game::fixed_update() noexcept -> Result<> {
+    if (!_fixed_update) return {};
+    if (auto r = _fixed_update->operator()(); !r) return err(r);
+    return {};
+}
+
 [[nodiscard]]
 auto Game::draw() noexcept -> Result<> {
     if (!_draw) return {};
@@ -359,34 +658,34 @@ auto Game::draw() noexcept -> Result<> {
 }
 
 [[nodiscard]]
-auto Game::try_reload() noexcept -> Result<> try {
-    std::optional<js::Value> state {};
-    SPDLOG_TRACE("Reloading game");
-
-    if (_pre_reload) {
-        SPDLOG_TRACE("Game has preReload, so calling it");
-        auto r = _pre_reload->operator()();
-        if (!r) return err(r);
-        state = std::move(*r);
-    }
-
-    SPDLOG_TRACE("Recreating game");
-    auto game_result = Game::create(_js, _store);
-    if (!game_result) return err(game_result);
-    auto new_game = std::move(*game_result);
+auto Game::save_state() noexcept -> Result<std::optional<std::vector<uint8_t>>> try {
+    if (!_pre_reload) return std::nullopt;
+    SPDLOG_TRACE("Game has preReload, so calling it");
+    auto state = _pre_reload->operator()();
+    if (!state) return err(state);
+
+    // Objects keep their context alive through prototypes, so state crosses to the new one as bytes
+    auto size = size_t {0};
+    auto buf = JS_WriteObject(_js, &size, state->cget(), JS_WRITE_OBJ_REFERENCE);
+    if (buf == nullptr) return err(js::JSError(js::own(_js, JS_GetException(_js))));
+    defer(js_free(_js, buf));
+    return std::vector<uint8_t>(buf, buf + size);
+} catch (std::exception& e) {
+    return err(e);
+}
 
-    if (new_game._post_reload) {
-        SPDLOG_TRACE("New game has postReload, so calling it");
-        if (state) {
-            auto args = std::array {*state};
-            if (auto r = new_game._post_reload->operator()(args); !r) return err(r);
-        } else {
-            if (auto r = new_game._post_reload->operator()(); !r) return err(r);
-        }
+[[nodiscard]]
+auto Game::restore_state(std::optional<std::span<const uint8_t>> state) noexcept -> Result<> try {
+    if (!_post_reload) return {};
+    SPDLOG_TRACE("Game has postReload, so calling it");
+    if (!state) {
+        if (auto r = _post_reload->operator()(); !r) return err(r);
+        return {};
     }
 
-    SPDLOG_TRACE("Successfully reloaded game");
-    *this = std::move(new_game);
+    auto value = js::own(_js, JS_ReadObject(_js, state->data(), state->size(), JS_READ_OBJ_REFERENCE));
+    if (JS_IsException(value.cget())) return err(js::JSError(js::own(_js, JS_GetException(_js))));
+    if (auto r = _post_reload->operator()(std::span(&value, 1)); !r) return err(r);
     return {};
 } catch (std::exception& e) {
     return err(e);
@@ -398,10 +697,20 @@ Game::Game(InitParams p) noexcept :
     _config(std::move(p.config)),
     _load(std::move(p.load)),
     _update(std::move(p.update)),
+    _fixed_update(std::move(p.fixed_update)),
     _draw(std::move(p.draw)),
     _pre_reload(std::move(p.pre_reload)),
     _post_reload(std::move(p.post_reload)) {}
 
+extern "C" auto module_normalize(JSContext *ctx, const char *base_name, const char *module_name, void *opaque) noexcept
+    -> char * try {
+    auto e = static_cast<Engine *>(opaque);
+    return js_strdup(ctx, e->resolve_module(base_name, module_name).c_str());
+} catch (std::exception& e) {
+    JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+    return nullptr;
+}
+
 extern "C" auto module_loader(JSContext *ctx, const char *module_name, void *opaque) noexcept -> JSModuleDef * {
     SPDLOG_DEBUG("Loading module {}", module_name);
     auto e = static_cast<Engine *>(opaque);
@@ -432,6 +741,22 @@ auto read_config(js::Object& ns) -> Result<GameConfig> {
     auto obj_opt = std::move(*obj_result);
     if (!obj_opt) return config;
     auto obj = std::move(*obj_opt); // NOLINT
+
+    auto loader_obj_result = obj.at<std::optional<js::Object>>("loader");
+    if (!loader_obj_result) return err(loader_obj_result);
+    if (loader_obj_result->has_value()) {
+        auto loader_obj = std::move(**loader_obj_result); // NOLINT
+        GLINT_GAMECONFIG_READ_OPTIONAL(loader_obj, config.loader.uploads_per_frame, uploadsPerFrame);
+    }
+
+    auto loop_obj_result = obj.at<std::optional<js::Object>>("loop");
+    if (!loop_obj_result) return err(loop_obj_result);
+    if (loop_obj_result->has_value()) {
+        auto loop_obj = std::move(**loop_obj_result); // NOLINT
+        GLINT_GAMECONFIG_READ_OPTIONAL(loop_obj, config.loop.fixed_update_hz, fixedUpdateHz);
+        GLINT_GAMECONFIG_READ_OPTIONAL(loop_obj, config.loop.max_fixed_updates, maxFixedUpdates);
+    }
+
     auto window_obj_result = obj.at<std::optional<js::Object>>("window");
     if (!window_obj_result) return err(window_obj_result);
     if (!window_obj_result->has_value()) return config;
@@ -462,7 +787,14 @@ auto read_config(js::Object& ns) -> Result<GameConfig> {
 
 } // namespace glint
 
+#include "./engine/atlas.cpp"
 #include "./engine/audio.cpp"
 #include "./engine/music.cpp"
 #include "./engine/sound.cpp"
+#include "./engine/bytecode.cpp"
+#include "./engine/loader.cpp"
+#include "./engine/modules.cpp"
+#include "./engine/profiler.cpp"
+#include "./engine/timestep.cpp"
+#include "./engine/watcher.cpp"
 #include "./engine/window.cpp"
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <gsl/gsl>
@@ -8,7 +9,15 @@
 
 #include <quickjs.hpp>
 #include <types.hpp>
+#include <engine/atlas.hpp>
+#include <engine/bytecode.hpp>
+#include <engine/loader.hpp>
+#include <engine/modules.hpp>
 #include <engine/plugin.hpp>
+#include <engine/profiler.hpp>
+#include <engine/timestep.hpp>
+#include <engine/watcher.hpp>
+#include <engine/window.hpp>
 #include <error.hpp>
 #include <file_store.hpp>
 #include <resource_store.hpp>
@@ -19,8 +28,17 @@ namespace glint {
 using namespace gsl;
 
 class Game;
+struct GameConfig;
 class Engine;
 
+struct RunOptions {
+    /// Run without a window: draw calls are validated but not rendered and frame time is fixed
+    bool headless = false;
+
+    /// Stop after running this many frames
+    std::optional<uint64_t> frames = std::nullopt;
+};
+
 class Engine {
   private:
     struct JSRuntime_deleter {
@@ -31,20 +49,68 @@ class Engine {
         auto operator()(JSContext *ctx) noexcept -> void;
     };
 
+    /// Runs plugin shutdown callbacks when destroyed
+    struct ShutdownCallbacks {
+        std::vector<std::function<auto()->Result<>>> callbacks {};
+
+        ShutdownCallbacks() = default;
+        ShutdownCallbacks(const ShutdownCallbacks&) = delete;
+        ShutdownCallbacks(ShutdownCallbacks&&) = delete;
+        auto operator=(const ShutdownCallbacks&) -> ShutdownCallbacks& = delete;
+        auto operator=(ShutdownCallbacks&&) -> ShutdownCallbacks& = delete;
+        ~ShutdownCallbacks();
+    };
+
+    /// Per-frame plugin callback, profiled under the plugin name
+    struct PluginCallback {
+        std::string plugin;
+        std::function<auto()->Result<>> callback;
+    };
+
+    /// Plugins and modules of one JS context, set aside while `reload_game` creates the next context
+    struct ContextState {
+        std::unordered_map<std::filesystem::path, std::string> js_modules {};
+        std::unordered_map<std::filesystem::path, JSModuleDef *> c_modules {};
+        std::vector<std::function<auto()->Result<>>> load_callbacks {};
+        std::vector<std::function<auto()->Result<>>> unload_callbacks {};
+        std::vector<std::function<auto()->Result<>>> shutdown_callbacks {};
+        std::vector<PluginCallback> update_callbacks {};
+        std::vector<PluginCallback> draw_callbacks {};
+        std::vector<PluginCallback> post_draw_callbacks {};
+        engine::modules::Graph modules {};
+        uint64_t loader_generation = 0;
+    };
+
   private:
+    /// Declared before JS runtime, so that callbacks run after its finalizers
+    ShutdownCallbacks _shutdown {};
     not_null<std::unique_ptr<IFileStore>> _file_store;
     ResourceStore<TextureData> _texture_store {};
     ResourceStore<FontData> _font_store {};
+    engine::atlas::Atlas _atlas {};
 
     not_null<std::unique_ptr<JSRuntime, JSRuntime_deleter>> _js_runtime;
     not_null<std::unique_ptr<JSContext, JSContext_deleter>> _js_context;
+    window::Window *_window = nullptr;
 
+    std::vector<plugins::PluginFactory> _plugin_factories {};
     std::unordered_map<std::filesystem::path, std::string> _js_modules {};
     std::unordered_map<std::filesystem::path, JSModuleDef *> _c_modules {};
     std::vector<std::function<auto()->Result<>>> _load_callbacks {};
     std::vector<std::function<auto()->Result<>>> _unload_callbacks {};
-    std::vector<std::function<auto()->Result<>>> _update_callbacks {};
-    std::vector<std::function<auto()->Result<>>> _draw_callbacks {};
+    std::vector<PluginCallback> _update_callbacks {};
+    std::vector<PluginCallback> _draw_callbacks {};
+    std::vector<PluginCallback> _post_draw_callbacks {};
+    engine::profiler::Profiler _profiler {};
+    engine::timestep::Timestep _timestep {};
+    std::optional<engine::bytecode::Cache> _bytecode_cache = std::nullopt;
+    engine::modules::Graph _modules {};
+    /// `preReload` state serialized on last reload, kept until a reloaded game receives it
+    std::optional<std::vector<uint8_t>> _reload_state = std::nullopt;
+    /// Watches game directory for changed modules, inactive when game runs from an archive
+    engine::watcher::Watcher _watcher {};
+    /// Declared after JS context so that pending tasks holding JS values are dropped first
+    engine::loader::Loader _loader {};
 
   public:
     [[nodiscard]]
@@ -71,20 +137,85 @@ class Engine {
     [[nodiscard]]
     auto font_store() noexcept -> ResourceStore<FontData>&;
 
-    /// Register plugin to engine
-    auto register_plugin(const plugins::EnginePlugin& desc) noexcept -> void;
+    [[nodiscard]]
+    auto atlas() noexcept -> engine::atlas::Atlas&;
+
+    [[nodiscard]]
+    auto profiler() noexcept -> engine::profiler::Profiler&;
+
+    [[nodiscard]]
+    auto loader() noexcept -> engine::loader::Loader&;
+
+    [[nodiscard]]
+    auto timestep() const noexcept -> const engine::timestep::Timestep&;
+
+    /// Window of the running game or nullptr if game is not running
+    [[nodiscard]]
+    auto game_window() const noexcept -> window::Window *;
+
+    /// Register plugin to engine, creating it for current context
+    auto register_plugin(plugins::PluginFactory factory) noexcept -> void;
 
     /// Call this after all plugins registered
     auto load_plugins() noexcept -> Result<>;
 
     /// Run game using engine
     [[nodiscard]]
-    auto run_game(Game& game) noexcept -> Result<>;
+    auto run_game(Game& game, const RunOptions& options = {}) noexcept -> Result<>;
+
+    [[nodiscard]]
+    auto load_module(const std::string& name) noexcept -> Result<owner<JSModuleDef *>>;
+
+    /// Name to load module `name` imported by module `base` under, recording game modules for reload
+    [[nodiscard]]
+    auto resolve_module(std::string_view base, std::string_view name) -> std::string;
+
+    /// Compile builtin module source. Builtins come with the engine, so they are not cached on disk.
+    /// Returns exception value on syntax error
+    [[nodiscard]]
+    auto compile_module(const std::string& name, const std::string& code) noexcept -> JSValue;
 
+    /// Compile module file from file store, preferring `.jsc` bytecode produced by `glint pack` in archives.
+    /// Returns exception value on syntax error
     [[nodiscard]]
-    auto load_module(const std::filesystem::path& path) noexcept -> Result<owner<JSModuleDef *>>;
+    auto compile_file(const std::filesystem::path& path, const std::string& name) noexcept -> Result<JSValue>;
+
+    /// Cache of compiled modules, null when game is not run from a directory
+    [[nodiscard]]
+    auto bytecode_cache() const noexcept -> const engine::bytecode::Cache *;
 
   private:
+    /// Add callbacks and modules of plugin created for current context
+    auto add_plugin(const plugins::EnginePlugin& desc) -> void;
+
+    /// Call unload callbacks of plugins, logging errors
+    auto unload_plugins() noexcept -> void;
+
+    /// Replace game with a new one evaluated in a fresh context, freeing context of previous one only once
+    /// the new game is created. If it fails to load, its context is freed instead and previous game keeps running.
+    /// State returned by `preReload` is carried over serialized; if it cannot be serialized or `postReload`
+    /// fails, new game runs without it
+    auto reload_game(Game& game) noexcept -> Result<>;
+
+    /// Apply loader and loop settings of game config, on start and after every reload
+    auto apply_config(const GameConfig& config) noexcept -> void;
+
+    /// Exchange plugins, modules and loader generation of current context with `state`
+    auto swap_context_state(ContextState& state) noexcept -> void;
+
+    /// Unload plugins of `state` and drop its loader tasks and callbacks, before its context is freed
+    auto release_context_state(ContextState& state) noexcept -> void;
+
+    /// Bytes allocated by JS runtime
+    [[nodiscard]]
+    auto heap_size() const noexcept -> int64_t;
+
+    /// Run queued promise reactions until job queue is empty
+    auto run_pending_jobs() noexcept -> void;
+
+    /// Invalidate modules changed on disk since last call. Returns true when game should be reloaded
+    auto poll_changed_modules() -> bool;
+
     Engine(
         std::unique_ptr<JSRuntime, JSRuntime_deleter>&& runtime,
         std::unique_ptr<JSContext, JSContext_deleter>&& context,
@@ -115,8 +246,20 @@ struct GameWindowConfig {
     bool interlaced_hint = false;
 };
 
+struct GameLoaderConfig {
+    int uploads_per_frame = 4;
+};
+
+struct GameLoopConfig {
+    /// Rate of `fixedUpdate` calls per second, disabled when zero
+    double fixed_update_hz = 0.0;
+    int max_fixed_updates = 5;
+};
+
 struct GameConfig {
     GameWindowConfig window;
+    GameLoaderConfig loader;
+    GameLoopConfig loop;
 };
 
 class Game {
@@ -126,6 +269,7 @@ class Game {
     GameConfig _config;
     std::optional<js::Function> _load;
     std::optional<js::Function> _update;
+    std::optional<js::Function> _fixed_update;
     std::optional<js::Function> _draw;
     std::optional<js::Function> _pre_reload;
     std::optional<js::Function> _post_reload;
@@ -142,11 +286,20 @@ class Game {
     [[nodiscard]]
     auto update() noexcept -> Result<>;
 
+    [[nodiscard]]
+    auto fixed_update() noexcept -> Result<>;
+
     [[nodiscard]]
     auto draw() noexcept -> Result<>;
 
+    /// Call `preReload` and serialize state it returns, so that game of another context can read it.
+    /// Empty if game has no `preReload`
+    [[nodiscard]]
+    auto save_state() noexcept -> Result<std::optional<std::vector<uint8_t>>>;
+
+    /// Call `postReload` with state saved by previous game, if any
     [[nodiscard]]
-    auto try_reload() noexcept -> Result<>;
+    auto restore_state(std::optional<std::span<const uint8_t>> state) noexcept -> Result<>;
 
   private:
     struct InitParams {
@@ -155,6 +308,7 @@ class Game {
         GameConfig config;
         std::optional<js::Function> load;
         std::optional<js::Function> update;
+        std::optional<js::Function> fixed_update;
         std::optional<js::Function> draw;
         std::optional<js::Function> pre_reload;
         std::optional<js::Function> post_reload;
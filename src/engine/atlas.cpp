@@ -0,0 +1,146 @@
+#include "./atlas.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace glint::engine::atlas {
+
+namespace {
+
+struct Shelf {
+    size_t page = 0;
+    int y = 0;
+    int height = 0;
+    /// First free column
+    int x = 0;
+};
+
+/// Repeats edge pixels of `image` drawn at `x`, `y` into `padding` pixels around it, so that filtering at the edges
+/// samples the image itself rather than transparent padding
+auto extend_edges(rl::Image& page, const rl::Image& image, int x, int y, int padding) -> void {
+    const auto w = image.width;
+    const auto h = image.height;
+    for (auto k = 1; k <= padding; k++) {
+        ImageDraw(&page, image, {0, 0, 1, float(h)}, {float(x - k), float(y), 1, float(h)}, WHITE);
+        ImageDraw(&page, image, {float(w - 1), 0, 1, float(h)}, {float(x + w - 1 + k), float(y), 1, float(h)}, WHITE);
+        ImageDraw(&page, image, {0, 0, float(w), 1}, {float(x), float(y - k), float(w), 1}, WHITE);
+        ImageDraw(&page, image, {0, float(h - 1), float(w), 1}, {float(x), float(y + h - 1 + k), float(w), 1}, WHITE);
+    }
+    ImageDrawRectangle(&page, x - padding, y - padding, padding, padding, GetImageColor(image, 0, 0));
+    ImageDrawRectangle(&page, x + w, y - padding, padding, padding, GetImageColor(image, w - 1, 0));
+    ImageDrawRectangle(&page, x - padding, y + h, padding, padding, GetImageColor(image, 0, h - 1));
+    ImageDrawRectangle(&page, x + w, y + h, padding, padding, GetImageColor(image, w - 1, h - 1));
+}
+
+} // namespace
+
+auto pack(std::span<const Size> sizes, int page_size, int padding) -> std::vector<std::optional<Placement>> {
+    auto placements = std::vector<std::optional<Placement>>(sizes.size());
+    auto order = std::vector<size_t>(sizes.size());
+    std::iota(order.begin(), order.end(), size_t {0});
+    std::ranges::stable_sort(order, std::ranges::greater {}, [&](size_t i) { return sizes[i].height; });
+
+    auto shelves = std::vector<Shelf> {};
+    // Height used by shelves of every page
+    auto page_heights = std::vector<int> {};
+    for (const auto i : order) {
+        const auto w = sizes[i].width + padding * 2;
+        const auto h = sizes[i].height + padding * 2;
+        if (sizes[i].width <= 0 || sizes[i].height <= 0 || w > page_size || h > page_size) continue;
+
+        auto shelf = std::ranges::find_if(shelves, [&](const Shelf& s) {
+            return h <= s.height && s.x + w <= page_size;
+        });
+        if (shelf == shelves.end()) {
+            auto page = std::ranges::find_if(page_heights, [&](int used) { return used + h <= page_size; });
+            if (page == page_heights.end()) page = page_heights.insert(page_heights.end(), 0);
+            shelves.push_back({.page = size_t(page - page_heights.begin()), .y = *page, .height = h});
+            *page += h;
+            shelf = shelves.end() - 1;
+        }
+
+        placements[i] = Placement {.page = shelf->page, .x = shelf->x + padding, .y = shelf->y + padding};
+        shelf->x += w;
+    }
+    return placements;
+}
+
+auto build(
+    Atlas& self,
+    ResourceStore<TextureData>& textures,
+    IFileStore& files,
+    std::span<const std::string> paths,
+    const Options& options
+) -> Result<size_t> {
+    auto names = std::vector<std::string> {};
+    auto images = std::vector<rl::Image> {};
+    for (const auto& path : paths) {
+        if (self.regions.contains(path) || std::ranges::find(names, path) != names.end()) continue;
+        auto file = files.map(path);
+        if (!file) return err(fmt::format("Could not read `{}` for atlas: {}", path, file.error()->msg()));
+        const auto extension = std::filesystem::path(path).extension().string();
+        auto image = rl::Image::load_from_memory(extension.c_str(), file->data());
+        if (!IsImageValid(image)) return err(fmt::format("Could not decode `{}` for atlas", path));
+        names.push_back(path);
+        images.push_back(std::move(image));
+    }
+    if (images.empty()) return size_t {0};
+
+    auto sizes = std::vector<Size> {};
+    for (const auto& image : images) sizes.push_back({.width = image.width, .height = image.height});
+    const auto placements = pack(sizes, options.page_size, std::max(options.padding, 0));
+
+    auto page_count = size_t {0};
+    for (const auto& p : placements) {
+        if (p) page_count = std::max(page_count, p->page + 1);
+    }
+
+    auto pages = std::vector<rl::Image> {};
+    for (auto i = size_t {0}; i < page_count; i++) {
+        pages.push_back(rl::Image::gen_color(options.page_size, options.page_size, BLANK));
+    }
+    for (auto i = size_t {0}; i < images.size(); i++) {
+        const auto& p = placements[i];
+        if (!p) {
+            SPDLOG_WARN("`{}` does not fit into {}px atlas page, keeping it separate", names[i], options.page_size);
+            continue;
+        }
+        const auto w = float(images[i].width);
+        const auto h = float(images[i].height);
+        ImageDraw(&pages[p->page], images[i], {0, 0, w, h}, {float(p->x), float(p->y), w, h}, WHITE);
+        extend_edges(pages[p->page], images[i], p->x, p->y, std::max(options.padding, 0));
+    }
+
+    const auto first_page = self.pages.size();
+    for (auto i = size_t {0}; i < page_count; i++) {
+        const auto name = fmt::format("atlas:{}", self.created_pages++);
+        self.pages.push_back(textures.load(name, [&] { return TextureData::from_image(name, pages[i]); }));
+    }
+    for (auto i = size_t {0}; i < images.size(); i++) {
+        const auto& p = placements[i];
+        if (!p) continue;
+        self.regions[names[i]] = Region {
+            .page = self.pages[first_page + p->page],
+            .rect = {float(p->x), float(p->y), float(images[i].width), float(images[i].height)},
+        };
+    }
+
+    SPDLOG_DEBUG("Packed {} images into {} atlas pages", images.size(), page_count);
+    return page_count;
+}
+
+auto find(const Atlas& self, const std::string& path) noexcept -> const Region * {
+    const auto it = self.regions.find(path);
+    return it != self.regions.end() ? &it->second : nullptr;
+}
+
+auto clear(Atlas& self, ResourceStore<TextureData>& textures) noexcept -> void {
+    for (const auto page : self.pages) textures.release(page);
+    self.pages.clear();
+    self.regions.clear();
+}
+
+} // namespace glint::engine::atlas
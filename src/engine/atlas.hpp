@@ -0,0 +1,69 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <raylib.h>
+
+#include <data.hpp>
+#include <error.hpp>
+#include <file_store.hpp>
+#include <resource_store.hpp>
+
+namespace glint::engine::atlas {
+
+struct Size {
+    int width = 0;
+    int height = 0;
+};
+
+/// Position of a packed rectangle, excluding padding
+struct Placement {
+    size_t page = 0;
+    int x = 0;
+    int y = 0;
+};
+
+/// Packs rectangles into square pages of `page_size` using shelves, tallest first.
+/// Rectangles that do not fit into an empty page get no placement
+auto pack(std::span<const Size> sizes, int page_size, int padding) -> std::vector<std::optional<Placement>>;
+
+/// Part of an atlas page that stands in for a standalone image
+struct Region {
+    ResourceStore<TextureData>::Handle page = 0;
+    ::Rectangle rect {};
+};
+
+struct Options {
+    int page_size = 2048;
+    /// Pixels around every image repeating its edges, so filtering bleeds neither neighbours nor transparency in
+    int padding = 1;
+};
+
+/// Images packed into shared textures, keyed by file store path
+struct Atlas {
+    std::unordered_map<std::string, Region> regions {};
+    /// One reference to every page texture, released by `clear`
+    std::vector<ResourceStore<TextureData>::Handle> pages {};
+    /// Number of pages ever created, so page names stay unique after `clear`
+    size_t created_pages = 0;
+};
+
+/// Loads images at `paths` and packs them into new pages. Paths packed already are skipped, so calling it again
+/// after reload does not duplicate pages. Must be called from main thread. Returns number of new pages
+auto build(
+    Atlas& self,
+    ResourceStore<TextureData>& textures,
+    IFileStore& files,
+    std::span<const std::string> paths,
+    const Options& options
+) -> Result<size_t>;
+
+[[nodiscard]] auto find(const Atlas& self, const std::string& path) noexcept -> const Region *;
+
+auto clear(Atlas& self, ResourceStore<TextureData>& textures) noexcept -> void;
+
+} // namespace glint::engine::atlas
@@ -5,12 +5,11 @@
 namespace glint::engine::audio {
 
 auto init() noexcept -> void {
-    InitAudioDevice();
+    if (!IsAudioDeviceReady()) InitAudioDevice();
 }
 
 auto close() noexcept -> void {
-    // TODO: free sounds
-    CloseAudioDevice();
+    if (IsAudioDeviceReady()) CloseAudioDevice();
 }
 
 auto get() noexcept -> Audio& {
@@ -15,13 +15,16 @@ using namespace gsl;
 namespace music {
     struct Music {
         rl::Music music {};
-        std::unique_ptr<unsigned char[]> data;
+        FileView data;
         float volume = 1.0f;
         float pitch = 1.0f;
         float pan = 0.5f;
     };
 
     auto load(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<Music>;
+    /// Creates music streamed from file contents read beforehand, e.g. on a loader worker. `data` is read for as
+    /// long as music lives, so it should own its bytes rather than map a file that may change
+    auto from_memory(const std::filesystem::path& name, FileView data) noexcept -> Music;
     auto update(Music& self) noexcept -> void;
     auto play(Music& self) noexcept -> void;
     auto stop(Music& self) noexcept -> void;
@@ -48,6 +51,8 @@ namespace sound {
     };
 
     auto load(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<Sound>;
+    /// Creates sound from wave decoded beforehand, e.g. on a loader worker
+    auto from_wave(const ::Wave& wave) noexcept -> Sound;
     auto play(Sound& self) noexcept -> void;
     auto stop(Sound& self) noexcept -> void;
     auto pause(Sound& self) noexcept -> void;
@@ -69,7 +74,9 @@ struct Audio {
     std::set<Sound *> sounds {};
 };
 
+/// Opens audio device unless already open
 auto init() noexcept -> void;
+/// Closes audio device if open. Sounds and musics must be unloaded before
 auto close() noexcept -> void;
 auto get() noexcept -> Audio&;
 
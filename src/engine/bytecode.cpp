@@ -0,0 +1,210 @@
+#include "./bytecode.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <defer.hpp>
+#include <quickjs.hpp>
+
+namespace glint::engine::bytecode {
+
+namespace {
+
+/// Random per process, so that runs sharing a cache directory do not share temporary files
+auto writer_tag() -> uint32_t {
+    static const auto tag = std::random_device {}();
+    return tag;
+}
+
+auto next_writer = std::atomic<uint64_t> {0};
+
+constexpr auto fnv_offset = uint64_t {14695981039346656037ull};
+
+auto fnv1a(uint64_t hash, std::string_view bytes) noexcept -> uint64_t {
+    for (const auto c : bytes) {
+        hash ^= uint8_t(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+constexpr auto header_magic = std::array {'G', 'L', 'B', 'C'};
+constexpr auto header_format = uint32_t {1};
+
+/// Precedes QuickJS bytecode, which `JS_ReadObject` trusts blindly: a truncated or corrupt file would crash it
+struct Header {
+    std::array<char, 4> magic = header_magic;
+    uint32_t format = header_format;
+    /// Hash of QuickJS version, whose bytecode format changes between releases
+    uint64_t version = 0;
+    uint64_t length = 0;
+    /// Hash of bytecode following the header
+    uint64_t checksum = 0;
+};
+
+auto quickjs_version() noexcept -> uint64_t {
+    return fnv1a(fnv_offset, JS_GetVersion());
+}
+
+/// Cache files of module `name` start with this, so that older versions can be found
+auto entry_prefix(std::string_view name) -> std::string {
+    return fmt::format("{:016x}-", fnv1a(fnv_offset, name));
+}
+
+/// Removes cache entries of the module other than `keep`
+auto prune(const Cache& cache, std::string_view prefix, const std::filesystem::path& keep) -> void {
+    auto ec = std::error_code {};
+    auto it = std::filesystem::directory_iterator(cache.dir, ec);
+    for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        const auto filename = it->path().filename().string();
+        if (!filename.starts_with(prefix) || !filename.ends_with(".jsc") || it->path() == keep) continue;
+        auto remove_ec = std::error_code {};
+        if (std::filesystem::remove(it->path(), remove_ec)) SPDLOG_TRACE("Removed stale {}", it->path().string());
+    }
+}
+
+} // namespace
+
+auto source_hash(std::string_view name, std::string_view code) noexcept -> uint64_t {
+    // FNV-1a over engine version, module name and source
+    auto hash = fnv_offset;
+    const auto feed = [&](std::string_view bytes) {
+        hash = fnv1a(hash, bytes);
+        hash ^= 0xff;
+        hash *= 1099511628211ull;
+    };
+    feed(JS_GetVersion());
+    feed(name);
+    feed(code);
+    return hash;
+}
+
+auto write(JSContext *ctx, JSValueConst module) noexcept -> std::string try {
+    auto size = size_t {0};
+    auto buf = JS_WriteObject(ctx, &size, module, JS_WRITE_OBJ_BYTECODE);
+    if (buf == nullptr) {
+        JS_FreeValue(ctx, JS_GetException(ctx));
+        return {};
+    }
+    defer(js_free(ctx, buf));
+    const auto payload = std::string_view(reinterpret_cast<const char *>(buf), size);
+
+    const auto header = Header {.version = quickjs_version(), .length = size, .checksum = fnv1a(fnv_offset, payload)};
+    auto bytecode = std::string(sizeof(Header), '\0');
+    std::memcpy(bytecode.data(), &header, sizeof(Header));
+    bytecode += payload;
+    return bytecode;
+} catch (...) {
+    return {};
+}
+
+auto read(JSContext *ctx, std::string_view bytecode) noexcept -> JSValue {
+    if (bytecode.size() < sizeof(Header)) return JS_ThrowInternalError(ctx, "Bytecode is truncated");
+    auto header = Header {};
+    std::memcpy(&header, bytecode.data(), sizeof(Header));
+    const auto payload = bytecode.substr(sizeof(Header));
+    if (header.magic != header_magic || header.format != header_format) {
+        return JS_ThrowInternalError(ctx, "Not glint bytecode");
+    }
+    if (header.version != quickjs_version()) {
+        return JS_ThrowInternalError(ctx, "Bytecode was compiled by another QuickJS version");
+    }
+    if (header.length != payload.size() || header.checksum != fnv1a(fnv_offset, payload)) {
+        return JS_ThrowInternalError(ctx, "Bytecode is corrupt");
+    }
+
+    return JS_ReadObject(ctx, reinterpret_cast<const uint8_t *>(payload.data()), payload.size(), JS_READ_OBJ_BYTECODE);
+}
+
+auto compile_module(JSContext *ctx, const Cache *cache, const std::string& name, const std::string& code) noexcept
+    -> JSValue try {
+    const auto compile = [&] {
+        return JS_Eval(ctx, code.c_str(), code.size(), name.c_str(), JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
+    };
+    if (cache == nullptr) return compile();
+
+    const auto prefix = entry_prefix(name);
+    const auto path = cache->dir / fmt::format("{}{:016x}.jsc", prefix, source_hash(name, code));
+    if (auto file = std::ifstream {path, std::ios::in | std::ios::binary}) {
+        const auto bytecode = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        auto mod = read(ctx, bytecode);
+        if (!JS_IsException(mod)) {
+            SPDLOG_TRACE("Module {} loaded from bytecode cache {}", name, path.string());
+            // Unlike `JS_Eval`, `JS_ReadObject` does not resolve imports
+            if (JS_ResolveModule(ctx, mod) < 0) {
+                JS_FreeValue(ctx, mod);
+                return JS_EXCEPTION;
+            }
+            return mod;
+        }
+        auto e = js::JSError(js::own(ctx, JS_GetException(ctx)));
+        SPDLOG_WARN("Discarding invalid bytecode cache entry {}: {}", path.string(), e.msg());
+    }
+
+    auto mod = compile();
+    if (JS_IsException(mod)) return mod;
+
+    const auto bytecode = write(ctx, mod);
+    if (bytecode.empty()) return mod;
+
+    auto ec = std::error_code {};
+    std::filesystem::create_directories(cache->dir, ec);
+    // Write to temporary file first so concurrent runs never read a partial entry. Engine and worker threads
+    // may compile the same module at once, so every writer gets its own file
+    auto tmp = path;
+    tmp += fmt::format(".{:08x}-{}.tmp", writer_tag(), next_writer.fetch_add(1));
+    auto file = std::ofstream {tmp, std::ios::out | std::ios::binary | std::ios::trunc};
+    file.write(bytecode.data(), std::streamsize(bytecode.size()));
+    file.close();
+    if (file) std::filesystem::rename(tmp, path, ec);
+    if (!file || ec) {
+        SPDLOG_WARN("Could not write bytecode cache entry {}", path.string());
+        std::filesystem::remove(tmp, ec);
+    } else {
+        // Every edit of a module would otherwise leave another entry behind
+        prune(*cache, prefix, path);
+    }
+
+    return mod;
+} catch (std::exception& e) {
+    return JS_ThrowInternalError(ctx, "%s", e.what());
+}
+
+auto compile_file(
+    JSContext *ctx,
+    IFileStore& store,
+    const Cache *cache,
+    const std::filesystem::path& path,
+    const std::string& name
+) noexcept -> Result<JSValue> try {
+    // Only packed games are precompiled: in a game directory, a stale `.jsc` would shadow edited source
+    if (store.packed()) {
+        auto bytecode_path = path;
+        bytecode_path.replace_extension(".jsc");
+        if (auto bytecode = store.read_string(bytecode_path)) {
+            SPDLOG_TRACE("Loading precompiled module {}", bytecode_path.string());
+            auto mod = read(ctx, *bytecode);
+            if (JS_IsException(mod)) return mod;
+            if (JS_ResolveModule(ctx, mod) < 0) {
+                JS_FreeValue(ctx, mod);
+                return JS_EXCEPTION;
+            }
+            return mod;
+        }
+    }
+
+    const auto code = store.read_string(path);
+    if (!code) return err(code);
+    return compile_module(ctx, cache, name, *code);
+} catch (std::exception& e) {
+    return err(e);
+}
+
+} // namespace glint::engine::bytecode
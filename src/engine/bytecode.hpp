@@ -0,0 +1,45 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include <quickjs.h>
+
+#include <error.hpp>
+#include <file_store.hpp>
+
+namespace glint::engine::bytecode {
+
+/// On-disk cache of compiled modules keyed by module name and source hash. Only the latest entry of each module
+/// is kept
+struct Cache {
+    std::filesystem::path dir {};
+};
+
+/// Hash of module name and source used as cache key
+auto source_hash(std::string_view name, std::string_view code) noexcept -> uint64_t;
+
+/// Serializes compiled module to bytecode behind a header checked by `read`, returns empty string on failure
+auto write(JSContext *ctx, JSValueConst module) noexcept -> std::string;
+
+/// Deserializes bytecode written by `write`. Returns exception value on failure, including bytecode that is
+/// truncated, corrupt or written by another QuickJS version
+auto read(JSContext *ctx, std::string_view bytecode) noexcept -> JSValue;
+
+/// Compiles module source, reusing cached bytecode when source did not change.
+/// Behaves like `JS_Eval` with `JS_EVAL_FLAG_COMPILE_ONLY`: returns exception value on syntax error
+auto compile_module(JSContext *ctx, const Cache *cache, const std::string& name, const std::string& code) noexcept
+    -> JSValue;
+
+/// Compiles module file from `store`, preferring `.jsc` bytecode produced by `glint pack` when store is packed.
+/// Returns exception value on syntax error
+auto compile_file(
+    JSContext *ctx,
+    IFileStore& store,
+    const Cache *cache,
+    const std::filesystem::path& path,
+    const std::string& name
+) noexcept -> Result<JSValue>;
+
+} // namespace glint::engine::bytecode
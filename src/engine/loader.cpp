@@ -0,0 +1,108 @@
+#include "./loader.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include <spdlog/spdlog.h>
+
+namespace glint::engine::loader {
+
+namespace {
+
+auto worker_main(Loader& self) -> void {
+    for (;;) {
+        auto task = Task {};
+        {
+            auto lock = std::unique_lock(self.mutex);
+            self.cv.wait(lock, [&] { return self.stopping || !self.queued.empty(); });
+            if (self.stopping) return;
+            task = std::move(self.queued.front());
+            self.queued.pop_front();
+            self.working.push_back(task.generation);
+        }
+
+        try {
+            if (task.work) task.work();
+        } catch (std::exception& e) {
+            SPDLOG_ERROR("Unexpected C++ exception in loader worker: {}", e.what());
+        }
+
+        // Task still owns `finish`, which may hold JS values, so it is only destroyed on main thread
+        {
+            auto lock = std::lock_guard(self.mutex);
+            self.working.erase(std::ranges::find(self.working, task.generation));
+            self.done.push_back(std::move(task));
+        }
+        self.worked.notify_all();
+    }
+}
+
+} // namespace
+
+Loader::~Loader() {
+    shutdown(*this);
+}
+
+auto submit(Loader& self, Task task) -> void {
+    if (self.workers.empty()) {
+        const auto count = std::clamp(int(std::thread::hardware_concurrency()) - 1, 1, 4);
+        SPDLOG_DEBUG("Starting {} loader workers", count);
+        for (auto i = 0; i < count; i++) {
+            self.workers.emplace_back(worker_main, std::ref(self));
+        }
+    }
+
+    {
+        auto lock = std::lock_guard(self.mutex);
+        task.generation = self.generation;
+        self.queued.push_back(std::move(task));
+    }
+    self.cv.notify_one();
+}
+
+auto cancel(Loader& self, uint64_t generation) noexcept -> void {
+    // Dropped tasks may hold JS values, so they are destroyed here on main thread, outside of the lock
+    auto dropped = std::vector<Task> {};
+    {
+        auto lock = std::unique_lock(self.mutex);
+        self.worked.wait(lock, [&] { return std::ranges::find(self.working, generation) == self.working.end(); });
+        for (auto *tasks : {&self.queued, &self.done}) {
+            const auto kept = std::ranges::stable_partition(*tasks, [&](const Task& t) {
+                return t.generation != generation;
+            });
+            std::ranges::move(kept, std::back_inserter(dropped));
+            tasks->erase(kept.begin(), kept.end());
+        }
+    }
+    if (!dropped.empty()) SPDLOG_DEBUG("Dropped {} loader tasks of replaced game", dropped.size());
+}
+
+auto poll(Loader& self) -> void {
+    for (auto i = 0; i < self.uploads_per_frame; i++) {
+        auto task = Task {};
+        {
+            auto lock = std::lock_guard(self.mutex);
+            if (self.done.empty()) return;
+            task = std::move(self.done.front());
+            self.done.pop_front();
+        }
+        if (task.finish) task.finish();
+    }
+}
+
+auto shutdown(Loader& self) noexcept -> void {
+    {
+        auto lock = std::lock_guard(self.mutex);
+        self.stopping = true;
+    }
+    self.cv.notify_all();
+    for (auto& worker : self.workers) {
+        if (worker.joinable()) worker.join();
+    }
+    self.workers.clear();
+    self.queued.clear();
+    self.done.clear();
+    self.stopping = false;
+}
+
+} // namespace glint::engine::loader
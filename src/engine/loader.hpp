@@ -0,0 +1,56 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace glint::engine::loader {
+
+/// Asset loading job split between worker pool and main thread
+struct Task {
+    /// Runs on worker thread: reads files and decodes assets
+    std::function<void()> work = nullptr;
+    /// Runs on main thread after `work`: uploads to GPU and settles JS promise
+    std::function<void()> finish = nullptr;
+    /// Loader generation the task was submitted in, set by `submit`
+    uint64_t generation = 0;
+};
+
+struct Loader {
+    /// Maximum number of finished tasks completed on main thread per frame
+    int uploads_per_frame = 4;
+    std::vector<std::thread> workers {};
+    std::mutex mutex {};
+    std::condition_variable cv {};
+    std::deque<Task> queued {};
+    std::deque<Task> done {};
+    /// Generations of tasks workers are running `work` of
+    std::vector<uint64_t> working {};
+    /// Signalled whenever a worker moves a task to `done`
+    std::condition_variable worked {};
+    /// Stamped on submitted tasks, so that tasks of one game can be dropped with `cancel` when it is replaced
+    uint64_t generation = 0;
+    bool stopping = false;
+
+    Loader() = default;
+    Loader(const Loader&) = delete;
+    Loader(Loader&&) = delete;
+    auto operator=(const Loader&) -> Loader& = delete;
+    auto operator=(Loader&&) -> Loader& = delete;
+    ~Loader();
+};
+
+/// Queue task, starting worker threads on first use
+auto submit(Loader& self, Task task) -> void;
+/// Finish up to `uploads_per_frame` completed tasks. Must be called from main thread
+auto poll(Loader& self) -> void;
+/// Drop tasks submitted in `generation`, waiting for workers running them. Must be called from main thread
+auto cancel(Loader& self, uint64_t generation) noexcept -> void;
+/// Stop workers and drop unfinished tasks. Next `submit` starts workers again. Must be called from main thread
+auto shutdown(Loader& self) noexcept -> void;
+
+} // namespace glint::engine::loader
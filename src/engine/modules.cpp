@@ -0,0 +1,41 @@
+#include "./modules.hpp"
+
+#include <filesystem>
+#include <vector>
+
+namespace glint::engine::modules {
+
+auto resolve(std::string_view base, std::string_view name) -> std::string {
+    if (!name.starts_with("./") && !name.starts_with("../")) return std::string(name);
+    const auto dir = std::filesystem::path(base).parent_path();
+    return (dir / name).lexically_normal().generic_string();
+}
+
+auto normalize(std::string path) -> std::string {
+    if (!std::filesystem::path(path).has_extension()) path += ".js";
+    return path;
+}
+
+auto add(Graph& self, const std::string& path, std::string_view importer) -> void {
+    auto& importers = self.importers[path];
+    if (!importer.empty()) importers.insert(std::string(importer));
+}
+
+auto affected(const Graph& self, std::span<const std::string> changed) -> size_t {
+    auto stack = std::vector<std::string>(changed.begin(), changed.end());
+    auto visited = std::unordered_set<std::string> {};
+    while (!stack.empty()) {
+        auto path = std::move(stack.back());
+        stack.pop_back();
+        const auto it = self.importers.find(path);
+        if (it == self.importers.end() || !visited.insert(path).second) continue;
+        stack.insert(stack.end(), it->second.begin(), it->second.end());
+    }
+    return visited.size();
+}
+
+auto clear(Graph& self) -> void {
+    self.importers.clear();
+}
+
+} // namespace glint::engine::modules
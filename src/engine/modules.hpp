@@ -0,0 +1,34 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace glint::engine::modules {
+
+/// Game modules loaded into current context and who imports them, to tell which changed files need a reload
+struct Graph {
+    /// Paths of modules importing each loaded module, by module path
+    std::unordered_map<std::string, std::unordered_set<std::string>> importers {};
+};
+
+/// Resolves `name` imported by module `base`. Relative names are resolved against directory of `base`
+[[nodiscard]] auto resolve(std::string_view base, std::string_view name) -> std::string;
+
+/// Name of game module at `path`: `.js` is appended when it has no extension, so that `./a` and `./a.js`
+/// are one module. Modules compiled ahead of time must be named the same way, or they load twice
+[[nodiscard]] auto normalize(std::string path) -> std::string;
+
+/// Records that game module `path` is loaded, imported by `importer` when there is one
+auto add(Graph& self, const std::string& path, std::string_view importer = {}) -> void;
+
+/// Number of loaded modules affected by `changed` files: changed modules and every module importing them,
+/// directly or not. Other paths are ignored
+[[nodiscard]] auto affected(const Graph& self, std::span<const std::string> changed) -> size_t;
+
+/// Forgets every module, before they are loaded again into a new context
+auto clear(Graph& self) -> void;
+
+} // namespace glint::engine::modules
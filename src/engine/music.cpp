@@ -10,14 +10,17 @@ namespace glint::engine::audio::music {
 using namespace gsl;
 
 auto load(const std::filesystem::path& name, IFileStore &store) noexcept -> Result<Music> {
+    // Music is streamed from memory while playing, so it keeps its own copy: a mapping would fault
+    // as soon as the file is truncated, which editors do on every save the watcher reloads
     auto data = store.read_bytes(name);
     if (!data) return err(data);
-    auto buf = std::make_unique<unsigned char[]>(data->size());
-    std::ranges::copy(*data, buf.get());
-    auto span = std::span{buf.get(), data->size()};
-    auto raylib_music = rl::Music::load_from_memory(name.extension().string().c_str(), span);
+    return from_memory(name, FileView {std::move(*data)});
+}
+
+auto from_memory(const std::filesystem::path& name, FileView data) noexcept -> Music {
+    auto raylib_music = rl::Music::load_from_memory(name.extension().string().c_str(), data.data());
 
-    auto music = Music {.music = std::move(raylib_music), .data = std::move(buf)};
+    auto music = Music {.music = std::move(raylib_music), .data = std::move(data)};
 
     SetMusicVolume(music.music, music.volume);
     SetMusicPan(music.music, music.pan);
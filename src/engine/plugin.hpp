@@ -15,9 +15,18 @@ struct EnginePlugin {
     std::map<std::string, JSModuleDef *> c_modules {};
     std::map<std::string, std::string> js_modules {};
     std::function<auto()->Result<>> load = nullptr;
+    /// Called before the plugin's context is freed, on exit and on every game reload
     std::function<auto()->Result<>> unload = nullptr;
+    /// Called once after the JS runtime is freed, when every finalizer has run. Releases what outlives
+    /// contexts, like devices
+    std::function<auto()->Result<>> shutdown = nullptr;
     std::function<auto()->Result<>> update = nullptr;
     std::function<auto()->Result<>> draw = nullptr;
+    /// Called every frame after game draw
+    std::function<auto()->Result<>> post_draw = nullptr;
 };
 
+/// Creates plugin bound to a context. Called again with the new context on every game reload
+using PluginFactory = std::function<auto(JSContext *)->EnginePlugin>;
+
 } // namespace glint::plugins
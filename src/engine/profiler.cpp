@@ -0,0 +1,106 @@
+#include "./profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <fmt/format.h>
+#include <raylib.h>
+
+namespace glint::engine::profiler {
+
+Scope::Scope(Profiler& profiler, size_t track) noexcept :
+    _profiler(profiler),
+    _track(track),
+    _enabled(profiler.enabled),
+    _start(_enabled ? Clock::now() : Clock::time_point {}) {}
+
+Scope::~Scope() noexcept {
+    // Profiling may be toggled while the scope runs, but only a scope that took its start time can record
+    if (_enabled) record(_profiler, _track, Clock::now() - _start);
+}
+
+auto track(Profiler& self, std::string_view name) -> size_t {
+    const auto it = std::ranges::find(self.tracks, name, &Track::name);
+    if (it != self.tracks.end()) return size_t(it - self.tracks.begin());
+
+    self.tracks.push_back(Track {.name = std::string(name)});
+    return self.tracks.size() - 1;
+}
+
+auto record(Profiler& self, size_t track, Clock::duration duration) noexcept -> void {
+    self.tracks[track].samples[self.cursor] += std::chrono::duration<float, std::milli>(duration).count();
+}
+
+auto end_frame(Profiler& self) noexcept -> void {
+    if (!self.enabled) {
+        // Drop history, so that stats do not report old samples once profiling is enabled again
+        if (self.frames > 0) {
+            for (auto& track : self.tracks) {
+                track.samples.fill(0.0f);
+            }
+            self.frames = 0;
+        }
+        // Scopes started before profiling was disabled may still record into the current frame
+        for (auto& track : self.tracks) {
+            track.samples[self.cursor] = 0.0f;
+        }
+        return;
+    }
+
+    self.cursor = (self.cursor + 1) % history_size;
+    self.frames = std::min(self.frames + 1, history_size - 1);
+    for (auto& track : self.tracks) {
+        track.samples[self.cursor] = 0.0f;
+    }
+}
+
+auto stats(const Profiler& self, const Track& track) noexcept -> Stats {
+    if (self.frames == 0) return {};
+
+    // Completed frames are the `frames` samples right before the cursor
+    auto samples = std::array<float, history_size> {};
+    for (size_t i = 0; i < self.frames; i++) {
+        samples[i] = track.samples[(self.cursor + history_size - 1 - i) % history_size];
+    }
+    const auto n = self.frames;
+    const auto last = samples[0];
+
+    const auto percentile = [&](float p) -> float {
+        const auto rank = size_t(std::ceil(p * float(n))) - 1;
+        std::nth_element(samples.begin(), samples.begin() + ptrdiff_t(rank), samples.begin() + ptrdiff_t(n));
+        return samples[rank];
+    };
+
+    return Stats {
+        .last = last,
+        .p50 = percentile(0.50f),
+        .p95 = percentile(0.95f),
+        .p99 = percentile(0.99f),
+        .max = *std::max_element(samples.begin(), samples.begin() + ptrdiff_t(n)),
+    };
+}
+
+auto draw_overlay(const Profiler& self) -> void {
+    if (!self.overlay || !IsWindowReady()) return;
+
+    constexpr auto font_size = 10;
+    constexpr auto line_height = font_size + 2;
+    constexpr auto padding = 5;
+    constexpr auto width = 260;
+
+    const auto x = GetScreenWidth() - width - 10;
+    const auto y = 10;
+    const auto height = int(self.tracks.size() + 1) * line_height + padding * 2;
+    DrawRectangle(x, y, width, height, ColorAlpha(BLACK, 0.6f));
+
+    auto line_y = y + padding;
+    DrawText("phase              p50    p95    p99 ms", x + padding, line_y, font_size, GRAY);
+    for (const auto& track : self.tracks) {
+        line_y += line_height;
+        const auto s = stats(self, track);
+        const auto text = fmt::format("{:<16} {:6.2f} {:6.2f} {:6.2f}", track.name, s.p50, s.p95, s.p99);
+        DrawText(text.c_str(), x + padding, line_y, font_size, s.p99 > 16.7f ? ORANGE : RAYWHITE);
+    }
+}
+
+} // namespace glint::engine::profiler
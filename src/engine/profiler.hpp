@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace glint::engine::profiler {
+
+using Clock = std::chrono::steady_clock;
+
+/// Number of frames kept per track
+constexpr auto history_size = size_t {240};
+
+/// Timings of one phase over the last `history_size` frames, in milliseconds
+struct Track {
+    std::string name {};
+    std::array<float, history_size> samples {};
+};
+
+struct Stats {
+    float last = 0.0f;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+};
+
+struct Profiler {
+    std::vector<Track> tracks {};
+    /// Index of the sample written during the current frame
+    size_t cursor = 0;
+    /// Number of completed frames kept in history
+    size_t frames = 0;
+    bool enabled = true;
+    bool overlay = false;
+};
+
+/// Measures time from construction to destruction into a track
+class Scope {
+  public:
+    Scope(Profiler& profiler, size_t track) noexcept;
+    Scope(const Scope&) = delete;
+    Scope(Scope&&) = delete;
+    auto operator=(const Scope&) -> Scope& = delete;
+    auto operator=(Scope&&) -> Scope& = delete;
+    ~Scope() noexcept;
+
+  private:
+    Profiler& _profiler;
+    size_t _track;
+    /// Whether profiling was enabled at construction
+    bool _enabled;
+    Clock::time_point _start;
+};
+
+/// Returns index of track with given name, creating it if needed
+auto track(Profiler& self, std::string_view name) -> size_t;
+auto record(Profiler& self, size_t track, Clock::duration duration) noexcept -> void;
+/// Finishes current frame and clears samples of the next one. While disabled, clears history instead
+auto end_frame(Profiler& self) noexcept -> void;
+auto stats(const Profiler& self, const Track& track) noexcept -> Stats;
+auto draw_overlay(const Profiler& self) -> void;
+
+} // namespace glint::engine::profiler
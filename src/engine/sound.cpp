@@ -5,15 +5,14 @@
 namespace glint::engine::audio::sound {
 
 auto load(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<Sound> {
-    auto data = store.read_bytes(name);
+    auto data = store.map(name);
     if (!data) return err(data);
-    auto buf = std::make_unique<unsigned char[]>(data->size());
-    std::ranges::copy(*data, buf.get());
-    auto span = std::span {buf.get(), data->size()};
-    auto wave = rl::Wave::load_from_memory(name.extension().string().c_str(), span);
-    auto raylib_sound = rl::Sound::load_from_wave(wave);
+    auto wave = rl::Wave::load_from_memory(name.extension().string().c_str(), data->data());
+    return from_wave(wave);
+}
 
-    auto sound = Sound {.sound = std::move(raylib_sound)};
+auto from_wave(const ::Wave& wave) noexcept -> Sound {
+    auto sound = Sound {.sound = rl::Sound::load_from_wave(wave)};
     ::SetSoundVolume(sound.sound, sound.volume);
     ::SetSoundPan(sound.sound, sound.pan);
     ::SetSoundPitch(sound.sound, sound.pitch);
@@ -0,0 +1,30 @@
+#include "./timestep.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace glint::engine::timestep {
+
+auto configure(Timestep& self, double hz, int max_steps) noexcept -> void {
+    self.step = hz > 0.0 ? 1.0 / hz : 0.0;
+    self.max_steps = std::max(max_steps, 1);
+    self.accumulator = 0.0;
+}
+
+auto advance(Timestep& self, double frame_time) noexcept -> int {
+    if (self.step <= 0.0) return 0;
+
+    self.accumulator += std::max(frame_time, 0.0);
+    const auto steps = std::min(std::floor(self.accumulator / self.step), double(self.max_steps));
+    self.accumulator -= steps * self.step;
+    // Spiral of death: drop whole steps that did not fit, keeping the phase for interpolation
+    if (self.accumulator >= self.step) self.accumulator = std::fmod(self.accumulator, self.step);
+    return int(steps);
+}
+
+auto alpha(const Timestep& self) noexcept -> float {
+    if (self.step <= 0.0) return 0.0f;
+    return float(std::clamp(self.accumulator / self.step, 0.0, 1.0));
+}
+
+} // namespace glint::engine::timestep
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace glint::engine::timestep {
+
+/// Accumulator for running game simulation at a fixed rate independent of frame rate
+struct Timestep {
+    /// Seconds per fixed update, zero when fixed updates are disabled
+    double step = 0.0;
+    /// Maximum number of fixed updates per frame. Time beyond that is dropped, so a slow
+    /// frame cannot cause even more updates in the next one
+    int max_steps = 5;
+    /// Frame time not yet consumed by fixed updates
+    double accumulator = 0.0;
+    /// Set while fixed updates run, so `screen.dt` reports the fixed step
+    bool in_fixed_update = false;
+};
+
+/// Enable fixed updates at `hz` per second, or disable them when `hz` is not positive
+auto configure(Timestep& self, double hz, int max_steps) noexcept -> void;
+/// Accumulate frame time and return number of fixed updates to run this frame
+auto advance(Timestep& self, double frame_time) noexcept -> int;
+/// Fraction of the next fixed update already elapsed, in [0, 1). Zero when fixed updates are disabled
+auto alpha(const Timestep& self) noexcept -> float;
+
+} // namespace glint::engine::timestep
@@ -0,0 +1,171 @@
+#include "./watcher.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace glint::engine::watcher {
+
+namespace {
+
+auto hidden(const std::filesystem::path& name) -> bool {
+    return name.filename().string().starts_with('.');
+}
+
+auto changed(Watcher& self, const std::filesystem::path& path) -> void {
+    self.pending.insert(path);
+    self.last_change = Clock::now();
+}
+
+#ifdef __linux__
+
+constexpr auto watch_mask = uint32_t {IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR};
+
+/// Watch directory `relative` to base and every non-hidden directory below it
+auto add_directory(Watcher& self, const std::filesystem::path& relative) -> void {
+    const auto path = self.base / relative;
+    const auto wd = inotify_add_watch(self.fd, path.c_str(), watch_mask);
+    if (wd < 0) {
+        SPDLOG_WARN("Could not watch {}: {}", path.string(), strerror(errno));
+        return;
+    }
+    self.dirs[wd] = relative;
+
+    auto ec = std::error_code {};
+    for (auto it = std::filesystem::directory_iterator(path, ec); !ec && it != std::filesystem::directory_iterator();
+         it.increment(ec)) {
+        if (!it->is_directory(ec) || hidden(it->path())) continue;
+        add_directory(self, relative / it->path().filename());
+    }
+}
+
+auto handle(Watcher& self, const inotify_event& event) -> void {
+    if ((event.mask & IN_Q_OVERFLOW) != 0) {
+        SPDLOG_WARN("File watcher queue overflowed, some changes were missed");
+        return;
+    }
+    if ((event.mask & IN_IGNORED) != 0) {
+        self.dirs.erase(event.wd);
+        return;
+    }
+
+    const auto dir = self.dirs.find(event.wd);
+    if (dir == self.dirs.end() || event.len == 0) return;
+    // Name is padded with NULs up to `len`
+    const auto name = std::string_view(event.name);
+    if (name.starts_with('.')) return;
+    const auto path = dir->second / name;
+
+    if ((event.mask & IN_ISDIR) != 0) {
+        // Files written into new directory before its watch was added are missed, which editors do not do
+        add_directory(self, path);
+    } else if ((event.mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+        // Editors saving through a temporary file show up as a move
+        changed(self, path);
+    }
+}
+
+#else
+
+constexpr auto scan_interval = std::chrono::milliseconds(500);
+
+/// Record modification times of files below base, marking changed ones when `report` is set
+auto scan(Watcher& self, bool report) -> void {
+    auto ec = std::error_code {};
+    auto it = std::filesystem::recursive_directory_iterator(self.base, ec);
+    for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (hidden(it->path())) {
+            if (it->is_directory(ec)) it.disable_recursion_pending();
+            continue;
+        }
+        if (!it->is_regular_file(ec)) continue;
+
+        const auto time = it->last_write_time(ec);
+        if (ec) continue;
+        const auto relative = it->path().lexically_relative(self.base);
+        auto [entry, inserted] = self.times.try_emplace(relative, time);
+        if (!inserted && entry->second != time) {
+            entry->second = time;
+            if (report) changed(self, relative);
+        } else if (inserted && report) {
+            changed(self, relative);
+        }
+    }
+    self.last_scan = Clock::now();
+}
+
+#endif
+
+} // namespace
+
+Watcher::~Watcher() {
+    close(*this);
+}
+
+auto open(Watcher& self, const std::filesystem::path& base) -> Result<> try {
+    close(self);
+    self.base = base;
+#ifdef __linux__
+    self.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (self.fd < 0) {
+        self.base.clear();
+        return err(fmt::format("Could not start file watcher: {}", strerror(errno)));
+    }
+    add_directory(self, {});
+    SPDLOG_DEBUG("Watching {} directories under {}", self.dirs.size(), base.string());
+#else
+    scan(self, false);
+    SPDLOG_DEBUG("Polling {} files under {} for changes", self.times.size(), base.string());
+#endif
+    return {};
+} catch (std::exception& e) {
+    close(self);
+    return err(e);
+}
+
+auto close(Watcher& self) noexcept -> void {
+#ifdef __linux__
+    if (self.fd >= 0) ::close(self.fd);
+    self.fd = -1;
+    self.dirs.clear();
+#else
+    self.times.clear();
+#endif
+    self.base.clear();
+    self.pending.clear();
+}
+
+auto poll(Watcher& self) -> std::vector<std::filesystem::path> {
+    if (self.base.empty()) return {};
+
+#ifdef __linux__
+    alignas(inotify_event) auto buf = std::array<char, 4096> {};
+    for (;;) {
+        const auto n = ::read(self.fd, buf.data(), buf.size());
+        if (n <= 0) break;
+        for (auto offset = ptrdiff_t {0}; offset < n;) {
+            const auto event = reinterpret_cast<const inotify_event *>(buf.data() + offset);
+            offset += ptrdiff_t(sizeof(inotify_event) + event->len);
+            handle(self, *event);
+        }
+    }
+#else
+    if (Clock::now() - self.last_scan >= scan_interval) scan(self, true);
+#endif
+
+    if (self.pending.empty() || Clock::now() - self.last_change < self.settle) return {};
+    auto files = std::vector(self.pending.begin(), self.pending.end());
+    self.pending.clear();
+    return files;
+}
+
+} // namespace glint::engine::watcher
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <error.hpp>
+
+namespace glint::engine::watcher {
+
+using Clock = std::chrono::steady_clock;
+
+/// Reports files changed under a directory: through inotify on Linux, by polling modification times elsewhere
+struct Watcher {
+    /// Watched directory, empty while not watching
+    std::filesystem::path base {};
+    /// Changes are reported once no new ones arrived for this long, so saving several files reloads once
+    Clock::duration settle = std::chrono::milliseconds(100);
+    /// Changed files relative to `base`, waiting for `settle`
+    std::set<std::filesystem::path> pending {};
+    Clock::time_point last_change {};
+#ifdef __linux__
+    int fd = -1;
+    /// Watched directories relative to `base`, by watch descriptor
+    std::unordered_map<int, std::filesystem::path> dirs {};
+#else
+    /// Modification times of files relative to `base` at the last scan
+    std::unordered_map<std::filesystem::path, std::filesystem::file_time_type> times {};
+    Clock::time_point last_scan {};
+#endif
+
+    Watcher() = default;
+    Watcher(const Watcher&) = delete;
+    Watcher(Watcher&&) = delete;
+    auto operator=(const Watcher&) -> Watcher& = delete;
+    auto operator=(Watcher&&) -> Watcher& = delete;
+    ~Watcher();
+};
+
+/// Start watching `base` and directories below it, skipping hidden ones like `.glint`
+auto open(Watcher& self, const std::filesystem::path& base) -> Result<>;
+/// Stop watching
+auto close(Watcher& self) noexcept -> void;
+/// Files changed since last reported, relative to `base`. Empty until changes settle. Never blocks
+auto poll(Watcher& self) -> std::vector<std::filesystem::path>;
+
+} // namespace glint::engine::watcher
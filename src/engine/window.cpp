@@ -15,6 +15,12 @@ auto setup() -> void {
 }
 
 auto create(const Config &config) -> Window {
+    if (config.headless) {
+        auto w = Window {.config = config};
+        SPDLOG_INFO("Running headless with fixed frame time of {}s", frame_time(w));
+        return w;
+    }
+
     unsigned int flags = config.window_flags;
 
     SetConfigFlags(flags);
@@ -23,30 +29,59 @@ auto create(const Config &config) -> Window {
     return Window {.config = config};
 }
 
-auto close(Window&) -> void {
+auto close(Window& self) -> void {
+    if (self.config.headless) return;
     CloseWindow();
 }
 
-auto should_close(Window&) -> bool {
+auto should_close(Window& self) -> bool {
+    if (self.config.headless) return false;
     return WindowShouldClose();
 }
 
-auto begin_drawing(Window&) -> void {
+auto begin_drawing(Window& self) -> void {
+    if (self.config.headless) return;
     BeginDrawing();
 }
 
-auto end_drawing(Window&) -> void {
+auto end_drawing(Window& self) -> void {
+    if (self.config.headless) {
+        self.headless_time += frame_time(self);
+        return;
+    }
     EndDrawing();
 }
 
-auto clear(Window&) -> void {
+auto clear(Window& self) -> void {
+    if (self.config.headless) return;
     ClearBackground(BLACK);
 }
 
-auto draw_fps(Window&) -> void {
+auto draw_fps(Window& self) -> void {
+    if (self.config.headless) return;
     DrawFPS(15, 15);
 }
 
+auto frame_time(const Window& self) -> float {
+    if (self.config.headless) return 1.0f / float(self.config.fps > 0 ? self.config.fps : 60);
+    return GetFrameTime();
+}
+
+auto time(const Window& self) -> double {
+    if (self.config.headless) return self.headless_time;
+    return GetTime();
+}
+
+auto width(const Window& self) -> int {
+    if (self.config.headless) return self.config.width;
+    return GetScreenWidth();
+}
+
+auto height(const Window& self) -> int {
+    if (self.config.headless) return self.config.height;
+    return GetScreenHeight();
+}
+
 // NOLINTBEGIN
 void spdlog_tracelog_callback(int logLevel, const char *text, va_list args) {
     constexpr auto bufLen = 128;
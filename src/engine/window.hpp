@@ -10,10 +10,13 @@ struct Config {
     int fps;
     std::string title;
     int window_flags;
+    /// Do not open a window. Drawing becomes no-op and time advances by fixed `1 / fps` steps
+    bool headless = false;
 };
 
 struct Window {
     Config config;
+    double headless_time = 0.0;
 };
 
 auto setup() -> void;
@@ -24,5 +27,9 @@ auto begin_drawing(Window& self) -> void;
 auto end_drawing(Window& self) -> void;
 auto clear(Window& self) -> void;
 auto draw_fps(Window& self) -> void;
+auto frame_time(const Window& self) -> float;
+auto time(const Window& self) -> double;
+auto width(const Window& self) -> int;
+auto height(const Window& self) -> int;
 
 } // namespace window
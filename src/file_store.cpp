@@ -1,8 +1,13 @@
 #include <file_store.hpp>
 
+#include <algorithm>
+#include <array>
 #include <fstream>
-#include <iterator>
-#include <sstream>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 #include <fmt/format.h>
 #include <zip.h>
@@ -10,8 +15,121 @@
 
 #include <defer.hpp>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace glint {
 
+FileView::FileView(std::vector<char>&& bytes) noexcept : _owned(std::move(bytes)) {
+    _bytes = _owned;
+}
+
+auto FileView::from_mapping(void *address, size_t size) noexcept -> FileView {
+    auto view = FileView {};
+    view._mapping = address;
+    view._bytes = std::span(static_cast<const char *>(address), size);
+    return view;
+}
+
+auto FileView::borrowed(std::span<const char> bytes) noexcept -> FileView {
+    auto view = FileView {};
+    view._bytes = bytes;
+    return view;
+}
+
+FileView::FileView(FileView&& other) noexcept :
+    _bytes(other._bytes),
+    _owned(std::move(other._owned)),
+    _mapping(other._mapping) {
+    // Moving vector keeps its heap buffer, so `_bytes` stays valid
+    other._bytes = {};
+    other._mapping = nullptr;
+}
+
+auto FileView::operator=(FileView&& other) noexcept -> FileView& {
+    // Swapped out mapping is released by destructor of `other`
+    std::swap(_bytes, other._bytes);
+    std::swap(_owned, other._owned);
+    std::swap(_mapping, other._mapping);
+    return *this;
+}
+
+FileView::~FileView() {
+    if (_mapping == nullptr) return;
+#ifdef _WIN32
+    UnmapViewOfFile(_mapping);
+#else
+    munmap(_mapping, _bytes.size());
+#endif
+    _mapping = nullptr;
+}
+
+namespace {
+
+/// Map whole file read-only, `name` is used in error messages
+auto map_file(const std::filesystem::path& path, const std::filesystem::path& name) noexcept -> Result<FileView> try {
+#ifdef _WIN32
+    auto file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) return err(fmt::format("Could not open {}", name.string()));
+    defer(CloseHandle(file));
+
+    auto size = LARGE_INTEGER {};
+    if (!GetFileSizeEx(file, &size)) return err(fmt::format("Could not stat {}", name.string()));
+    if (size.QuadPart == 0) return FileView {};
+
+    auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) return err(fmt::format("Could not map {}", name.string()));
+    defer(CloseHandle(mapping));
+
+    auto address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (address == nullptr) return err(fmt::format("Could not map {}", name.string()));
+    return FileView::from_mapping(address, size_t(size.QuadPart));
+#else
+    auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return err(fmt::format("Could not open {}: {}", name.string(), strerror(errno)));
+    defer(::close(fd));
+
+    struct stat st {};
+    if (fstat(fd, &st) < 0) return err(fmt::format("Could not stat {}: {}", name.string(), strerror(errno)));
+    if (st.st_size == 0) return FileView {};
+
+    const auto size = size_t(st.st_size);
+    auto address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+        return err(fmt::format("Could not map {}: {}", name.string(), strerror(errno)));
+    }
+    // Decoders read the whole file right away
+    madvise(address, size, MADV_WILLNEED);
+    return FileView::from_mapping(address, size);
+#endif
+} catch (std::exception& e) {
+    return err(e);
+}
+
+} // namespace
+
+auto IFileStore::map(const std::filesystem::path& path) noexcept -> Result<FileView> {
+    auto bytes = read_bytes(path);
+    if (!bytes) return err(bytes);
+    return FileView(std::move(*bytes));
+}
+
 auto FilesystemStore::open(std::filesystem::path base_path) noexcept -> Result<FilesystemStore> {
     auto store = FilesystemStore {std::move(base_path)};
     return store;
@@ -31,9 +149,11 @@ auto FilesystemStore::read(const std::filesystem::path& file_path, std::ostream&
 auto FilesystemStore::read_bytes(const std::filesystem::path& file_path) noexcept -> Result<std::vector<char>> try {
     const auto path = _base_path / file_path;
     SPDLOG_TRACE("Reading file `{}` to vector", path.string());
-    auto file = std::ifstream {path, std::ios::in | std::ios::binary};
-    auto eos = std::istreambuf_iterator<char>();
-    auto buf = std::vector<char>(std::istreambuf_iterator<char>(file), eos);
+    auto file = std::ifstream {path, std::ios::in | std::ios::binary | std::ios::ate};
+    if (!file) return err(fmt::format("Could not read {}: {}", file_path.string(), strerror(errno)));
+    auto buf = std::vector<char>(size_t(file.tellg()));
+    file.seekg(0);
+    file.read(buf.data(), std::streamsize(buf.size()));
     if (!file) return err(fmt::format("Could not read {}: {}", file_path.string(), strerror(errno)));
     return buf;
 } catch (std::exception& e) {
@@ -43,23 +163,225 @@ auto FilesystemStore::read_bytes(const std::filesystem::path& file_path) noexcep
 auto FilesystemStore::read_string(const std::filesystem::path& file_path) noexcept -> Result<std::string> try {
     const auto path = _base_path / file_path;
     SPDLOG_TRACE("Reading file `{}` to string", path.string());
-    auto file = std::ifstream {path, std::ios::in | std::ios::binary};
-    auto buf = std::stringstream {};
-    buf << file.rdbuf();
+    auto file = std::ifstream {path, std::ios::in | std::ios::binary | std::ios::ate};
     if (!file) return err(fmt::format("Could not read {}: {}", file_path.string(), strerror(errno)));
-    return buf.str();
+    auto buf = std::string(size_t(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(buf.data(), std::streamsize(buf.size()));
+    if (!file) return err(fmt::format("Could not read {}: {}", file_path.string(), strerror(errno)));
+    return buf;
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto FilesystemStore::map(const std::filesystem::path& file_path) noexcept -> Result<FileView> try {
+    const auto path = _base_path / file_path;
+    SPDLOG_TRACE("Mapping file `{}`", path.string());
+    return map_file(path, file_path);
 } catch (std::exception& e) {
     return err(e);
 }
 
 FilesystemStore::FilesystemStore(std::filesystem::path&& base_path) noexcept : _base_path(std::move(base_path)) {}
 
+namespace {
+
+constexpr auto zip_buffer_size = 512ul * 1024ul;
+
+using ZipBuffer = std::array<char, zip_buffer_size>;
+
+/// Little-endian integer at `offset`, or nothing when it would be out of bounds
+template<typename T>
+auto read_le(std::span<const char> bytes, size_t offset) noexcept -> std::optional<T> {
+    if (offset > bytes.size() || bytes.size() - offset < sizeof(T)) return std::nullopt;
+    auto value = T {};
+    for (auto i = size_t {0}; i < sizeof(T); i++) {
+        value |= T(static_cast<unsigned char>(bytes[offset + i])) << (8 * i);
+    }
+    return value;
+}
+
+/// Find data offsets of entries stored without compression by walking central directory of mapped archive.
+/// libzip does not expose them, entries it cannot describe (zip64, encrypted) are just left to be inflated
+auto locate_stored_entries(
+    std::span<const char> archive,
+    std::unordered_map<std::string, ZipStore::Entry>& index
+) noexcept -> size_t try {
+    constexpr auto eocd_signature = uint32_t {0x06054b50};
+    constexpr auto cdir_signature = uint32_t {0x02014b50};
+    constexpr auto local_signature = uint32_t {0x04034b50};
+    constexpr auto eocd_size = size_t {22};
+    constexpr auto max_comment_size = size_t {0xffff};
+    constexpr auto cdir_header_size = size_t {46};
+    constexpr auto local_header_size = size_t {30};
+
+    if (archive.size() < eocd_size) return 0;
+    auto eocd = std::optional<size_t> {};
+    const auto lowest = archive.size() - std::min(archive.size(), eocd_size + max_comment_size);
+    for (auto pos = archive.size() - eocd_size + 1; pos-- > lowest;) {
+        if (read_le<uint32_t>(archive, pos) == eocd_signature) {
+            eocd = pos;
+            break;
+        }
+    }
+    if (!eocd) return 0;
+
+    const auto count = read_le<uint16_t>(archive, *eocd + 10);
+    const auto cdir_offset = read_le<uint32_t>(archive, *eocd + 16);
+    if (!count || !cdir_offset || *count == 0xffff || *cdir_offset == 0xffffffff) return 0;
+
+    auto found = size_t {0};
+    auto pos = size_t(*cdir_offset);
+    for (auto i = 0; i < *count; i++) {
+        if (read_le<uint32_t>(archive, pos) != cdir_signature) break;
+        const auto flags = read_le<uint16_t>(archive, pos + 8).value_or(0);
+        const auto method = read_le<uint16_t>(archive, pos + 10).value_or(0);
+        const auto compressed_size = read_le<uint32_t>(archive, pos + 20).value_or(0);
+        const auto size = read_le<uint32_t>(archive, pos + 24).value_or(0);
+        const auto name_size = read_le<uint16_t>(archive, pos + 28).value_or(0);
+        const auto extra_size = read_le<uint16_t>(archive, pos + 30).value_or(0);
+        const auto comment_size = read_le<uint16_t>(archive, pos + 32).value_or(0);
+        const auto local_offset = read_le<uint32_t>(archive, pos + 42).value_or(0xffffffff);
+        const auto name_offset = pos + cdir_header_size;
+        if (name_offset + name_size > archive.size()) break;
+        pos = name_offset + name_size + extra_size + comment_size;
+
+        const auto encrypted = (flags & 1u) != 0;
+        if (method != ZIP_CM_STORE || encrypted || compressed_size != size || local_offset == 0xffffffff) continue;
+        const auto entry = index.find(std::string(archive.data() + name_offset, name_size));
+        if (entry == index.end() || entry->second.size != size) continue;
+
+        if (read_le<uint32_t>(archive, local_offset) != local_signature) continue;
+        const auto local_name_size = read_le<uint16_t>(archive, local_offset + 26);
+        const auto local_extra_size = read_le<uint16_t>(archive, local_offset + 28);
+        if (!local_name_size || !local_extra_size) continue;
+        const auto data_offset = size_t(local_offset) + local_header_size + *local_name_size + *local_extra_size;
+        if (data_offset > archive.size() || archive.size() - data_offset < size) continue;
+
+        entry->second.data_offset = data_offset;
+        found++;
+    }
+    return found;
+} catch (...) {
+    return 0;
+}
+
+} // namespace
+
+struct ZipStore::State {
+    std::filesystem::path path {};
+    std::unordered_map<std::string, Entry> index {};
+    std::mutex mutex {};
+    /// Archive handles not used by any thread. `zip_t` is not thread-safe, so each reader takes its own
+    std::vector<zip_t *> handles {};
+    std::vector<std::unique_ptr<ZipBuffer>> buffers {};
+    /// Whole archive mapped into memory, stored entries are viewed in place
+    FileView archive {};
+
+    State() = default;
+    State(const State&) = delete;
+    State(State&&) = delete;
+    auto operator=(const State&) -> State& = delete;
+    auto operator=(State&&) -> State& = delete;
+
+    ~State() {
+        for (auto zip : handles) zip_discard(zip);
+    }
+
+    auto acquire_handle() noexcept -> Result<zip_t *> {
+        {
+            auto lock = std::lock_guard(mutex);
+            if (!handles.empty()) {
+                auto zip = handles.back();
+                handles.pop_back();
+                return zip;
+            }
+        }
+        return open_handle(path);
+    }
+
+    auto release_handle(zip_t *zip) noexcept -> void try {
+        auto lock = std::lock_guard(mutex);
+        handles.push_back(zip);
+    } catch (...) {
+        zip_discard(zip);
+    }
+
+    auto acquire_buffer() -> std::unique_ptr<ZipBuffer> {
+        {
+            auto lock = std::lock_guard(mutex);
+            if (!buffers.empty()) {
+                auto buf = std::move(buffers.back());
+                buffers.pop_back();
+                return buf;
+            }
+        }
+        return std::make_unique<ZipBuffer>();
+    }
+
+    auto release_buffer(std::unique_ptr<ZipBuffer>&& buf) noexcept -> void try {
+        auto lock = std::lock_guard(mutex);
+        buffers.push_back(std::move(buf));
+    } catch (...) {}
+
+    static auto open_handle(const std::filesystem::path& path) noexcept -> Result<zip_t *> {
+        auto ec = int {};
+        auto zip = zip_open(path.string().c_str(), ZIP_RDONLY, &ec);
+        if (zip == nullptr) {
+            auto e = zip_error_t {};
+            zip_error_init_with_code(&e, ec);
+            defer(zip_error_fini(&e));
+            return err(fmt::format("Could not open archive `{}`: {}", path.string(), zip_error_strerror(&e)));
+        }
+        return zip;
+    }
+};
+
+auto ZipStore::find(const std::filesystem::path& path) const noexcept -> const Entry * try {
+    const auto it = _state->index.find(path.generic_string());
+    return it == _state->index.end() ? nullptr : &it->second;
+} catch (...) {
+    return nullptr;
+}
+
+auto ZipStore::read_entry(const Entry& entry, std::span<char> out) noexcept -> Result<> {
+    if (entry.data_offset) {
+        std::ranges::copy(_state->archive.bytes().subspan(*entry.data_offset, entry.size), out.begin());
+        return {};
+    }
+
+    auto zip = _state->acquire_handle();
+    if (!zip) return err(zip);
+    defer(_state->release_handle(*zip));
+
+    auto file = zip_fopen_index(*zip, entry.index, 0);
+    if (file == nullptr) return err(zip_strerror(*zip));
+    defer(zip_fclose(file));
+
+    // Size is known from index, so entry is inflated straight into output without intermediate copies
+    while (!out.empty()) {
+        auto n = zip_fread(file, out.data(), out.size());
+        if (n < 0) return err(zip_file_strerror(file));
+        if (n == 0) return err("Unexpected end of archive entry");
+        out = out.subspan(size_t(n));
+    }
+    return {};
+}
+
 auto ZipStore::read(const std::filesystem::path& path, std::ostream& stream) noexcept -> Result<> try {
-    auto file = zip_fopen(_zip, path.string().c_str(), 0);
-    if (file == nullptr) return err(zip_strerror(_zip));
+    const auto entry = find(path);
+    if (entry == nullptr) return err(fmt::format("File `{}` not found in archive", path.string()));
+
+    auto zip = _state->acquire_handle();
+    if (!zip) return err(zip);
+    defer(_state->release_handle(*zip));
+
+    auto file = zip_fopen_index(*zip, entry->index, 0);
+    if (file == nullptr) return err(zip_strerror(*zip));
     defer(zip_fclose(file));
 
-    auto buf = std::make_unique<std::array<char, 512ul * 1024ul>>();
+    auto buf = _state->acquire_buffer();
+    defer(_state->release_buffer(std::move(buf)));
     for (;;) {
         auto n = zip_fread(file, buf->data(), buf->size());
         if (n < 0) return err(zip_file_strerror(file));
@@ -75,81 +397,83 @@ auto ZipStore::read(const std::filesystem::path& path, std::ostream& stream) noe
 }
 
 auto ZipStore::read_bytes(const std::filesystem::path& path) noexcept -> Result<std::vector<char>> try {
-    auto stats = zip_stat_t {};
-    if (zip_stat(_zip, path.string().c_str(), 0, &stats) < 0) return err(zip_strerror(_zip));
-
-    auto file = zip_fopen(_zip, stats.name, 0);
-    if (file == nullptr) return err(zip_strerror(_zip));
-    defer(zip_fclose(file));
-
-    auto vec = std::vector<char> {};
-    vec.reserve(stats.size);
-    auto iter = std::back_inserter(vec);
-
-    auto buf = std::make_unique<std::array<char, 512ul * 1024ul>>();
-    for (;;) {
-        auto n = zip_fread(file, buf->data(), buf->size());
-        if (n < 0) return err(zip_file_strerror(file));
-        if (n == 0) break;
-
-        std::copy(buf->begin(), buf->begin() + n, iter);
-    }
+    const auto entry = find(path);
+    if (entry == nullptr) return err(fmt::format("File `{}` not found in archive", path.string()));
 
+    auto vec = std::vector<char>(entry->size);
+    if (auto r = read_entry(*entry, vec); !r) return err(r);
     return vec;
 } catch (std::exception& e) {
     return err(e);
 }
 
 auto ZipStore::read_string(const std::filesystem::path& path) noexcept -> Result<std::string> try {
-    auto file = zip_fopen(_zip, path.string().c_str(), 0);
-    if (file == nullptr) return err(zip_strerror(_zip));
-    defer(zip_fclose(file));
+    const auto entry = find(path);
+    if (entry == nullptr) return err(fmt::format("File `{}` not found in archive", path.string()));
 
-    auto str = std::string {};
-    auto buf = std::make_unique<std::array<char, 512ul * 1024ul>>();
-    for (;;) {
-        auto n = zip_fread(file, buf->data(), buf->size());
-        if (n < 0) return err(zip_file_strerror(file));
-        if (n == 0) break;
+    auto str = std::string(entry->size, '\0');
+    if (auto r = read_entry(*entry, str); !r) return err(r);
+    return str;
+} catch (std::exception& e) {
+    return err(e);
+}
 
-        str.append(buf->begin(), buf->begin() + n);
+auto ZipStore::map(const std::filesystem::path& path) noexcept -> Result<FileView> try {
+    const auto entry = find(path);
+    if (entry == nullptr) return err(fmt::format("File `{}` not found in archive", path.string()));
+    if (entry->data_offset) {
+        // Archive stays mapped for the lifetime of the store, same as any asset loaded from it
+        return FileView::borrowed(_state->archive.bytes().subspan(*entry->data_offset, entry->size));
     }
 
-    return str;
+    auto vec = std::vector<char>(entry->size);
+    if (auto r = read_entry(*entry, vec); !r) return err(r);
+    return FileView(std::move(vec));
 } catch (std::exception& e) {
     return err(e);
 }
 
 // TODO: Open from self
-auto ZipStore::open(const std::filesystem::path& path) noexcept -> Result<ZipStore> {
-    auto ec = int {};
-    auto zip = zip_open(path.string().c_str(), ZIP_RDONLY, &ec);
-    if (zip == nullptr) {
-        auto e = zip_error_t {};
-        zip_error_init_with_code(&e, ec);
-        defer(zip_error_fini(&e));
-        return err(fmt::format("Could not open archive `{}`: {}", path.string(), zip_error_strerror(&e)));
+auto ZipStore::open(const std::filesystem::path& path) noexcept -> Result<ZipStore> try {
+    auto zip = State::open_handle(path);
+    if (!zip) return err(zip);
+
+    auto state = std::make_unique<State>();
+    state->path = path;
+    state->handles.push_back(*zip);
+
+    // Index central directory once, so lookups do not go through libzip name search on every read
+    const auto count = zip_get_num_entries(*zip, 0);
+    state->index.reserve(size_t(std::max(count, zip_int64_t {0})));
+    for (auto i = zip_int64_t {0}; i < count; i++) {
+        auto stats = zip_stat_t {};
+        if (zip_stat_index(*zip, zip_uint64_t(i), 0, &stats) < 0) continue;
+        if ((stats.valid & ZIP_STAT_NAME) == 0 || (stats.valid & ZIP_STAT_SIZE) == 0) continue;
+        const auto name = std::string_view(stats.name);
+        if (name.empty() || name.back() == '/') continue;
+        state->index.emplace(name, Entry {.index = zip_uint64_t(i), .size = size_t(stats.size)});
     }
-    return ZipStore(zip);
-}
 
-ZipStore::ZipStore(ZipStore&& other) noexcept : _zip(other._zip) {
-    other._zip = nullptr;
-};
+    if (auto archive = map_file(path, path); archive && archive->mapped()) {
+        state->archive = std::move(*archive);
+        const auto stored = locate_stored_entries(state->archive.bytes(), state->index);
+        SPDLOG_DEBUG("{} entries of archive `{}` are readable without inflating", stored, path.string());
+    } else if (!archive) {
+        SPDLOG_DEBUG("Archive `{}` is not mapped: {}", path.string(), archive.error()->msg());
+    }
+    SPDLOG_DEBUG("Indexed {} entries of archive `{}`", state->index.size(), path.string());
 
-auto ZipStore::operator=(ZipStore&& other) noexcept -> ZipStore& {
-    // TODO: Free this->_zip?
-    auto zip = other._zip;
-    other._zip = nullptr;
-    _zip = zip;
-    return *this;
+    return ZipStore(std::move(state));
+} catch (std::exception& e) {
+    return err(e);
 }
 
-ZipStore::~ZipStore() {
-    if (_zip == nullptr) return;
-    zip_close(_zip);
-}
+ZipStore::ZipStore(ZipStore&& other) noexcept = default;
+
+auto ZipStore::operator=(ZipStore&& other) noexcept -> ZipStore& = default;
+
+ZipStore::~ZipStore() = default;
 
-ZipStore::ZipStore(zip_t *zip) : _zip(zip) {};
+ZipStore::ZipStore(std::unique_ptr<State>&& state) noexcept : _state(std::move(state)) {}
 
 } // namespace glint
@@ -1,16 +1,60 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <ostream>
+#include <span>
 #include <string>
 #include <vector>
 
 #include <error.hpp>
 
-using zip_t = struct zip;
-
 namespace glint {
 
+/// Read-only bytes of a file: either a memory mapping or an owned buffer
+class FileView {
+  public:
+    FileView() noexcept = default;
+
+    explicit FileView(std::vector<char>&& bytes) noexcept;
+
+    /// Takes ownership of mapping created by `mmap`/`MapViewOfFile`
+    static auto from_mapping(void *address, size_t size) noexcept -> FileView;
+
+    /// Views bytes owned by someone else, which must outlive the view
+    static auto borrowed(std::span<const char> bytes) noexcept -> FileView;
+
+    [[nodiscard]]
+    auto bytes() const noexcept -> std::span<const char> {
+        return _bytes;
+    }
+
+    [[nodiscard]]
+    auto data() const noexcept -> std::span<const unsigned char> {
+        // NOLINTNEXTLINE: viewing char as unsigned char is safe
+        return {reinterpret_cast<const unsigned char *>(_bytes.data()), _bytes.size()};
+    }
+
+    [[nodiscard]]
+    auto mapped() const noexcept -> bool {
+        return _mapping != nullptr;
+    }
+
+    FileView(const FileView&) = delete;
+    FileView(FileView&& other) noexcept;
+    auto operator=(const FileView&) -> FileView& = delete;
+    auto operator=(FileView&& other) noexcept -> FileView&;
+    ~FileView();
+
+  private:
+    std::span<const char> _bytes {};
+    std::vector<char> _owned {};
+    void *_mapping = nullptr;
+};
+
+/// Read-only game file storage. Methods may be called concurrently from loader worker threads
 class IFileStore {
   public:
     /// Read file to stream
@@ -22,6 +66,16 @@ class IFileStore {
     /// Read entire file and return bytes
     virtual auto read_string(const std::filesystem::path& path) noexcept -> Result<std::string> = 0;
 
+    /// Map entire file into memory without copying when store supports it, otherwise read it. Reading a mapped
+    /// view faults (SIGBUS) once the file is truncated, so views should be short-lived, e.g. decoded and dropped
+    virtual auto map(const std::filesystem::path& path) noexcept -> Result<FileView>;
+
+    /// True for archives made by `glint pack`, whose modules are precompiled to `.jsc` bytecode
+    [[nodiscard]]
+    virtual auto packed() const noexcept -> bool {
+        return false;
+    }
+
     virtual ~IFileStore() = default;
     IFileStore(const IFileStore&) = default;
     IFileStore(IFileStore&&) = default;
@@ -42,14 +96,26 @@ class FilesystemStore final: public IFileStore {
     auto read(const std::filesystem::path& path, std::ostream& stream) noexcept -> Result<> override;
     auto read_bytes(const std::filesystem::path& path) noexcept -> Result<std::vector<char>> override;
     auto read_string(const std::filesystem::path& path) noexcept -> Result<std::string> override;
+    auto map(const std::filesystem::path& path) noexcept -> Result<FileView> override;
 
   private:
     FilesystemStore(std::filesystem::path&& base_path) noexcept;
 };
 
 class ZipStore final: public IFileStore {
+  public:
+    /// Archive entry, as listed in central directory
+    struct Entry {
+        uint64_t index = 0;
+        size_t size = 0;
+        /// Offset of entry data in archive when it is stored without compression
+        std::optional<size_t> data_offset {};
+    };
+
   private:
-    zip_t *_zip;
+    struct State;
+    /// Entry index, idle archive handles and read buffers shared by all threads
+    std::unique_ptr<State> _state;
 
   public:
     static auto open(const std::filesystem::path& path) noexcept -> Result<ZipStore>;
@@ -57,6 +123,17 @@ class ZipStore final: public IFileStore {
     auto read(const std::filesystem::path& path, std::ostream& stream) noexcept -> Result<> override;
     auto read_bytes(const std::filesystem::path& path) noexcept -> Result<std::vector<char>> override;
     auto read_string(const std::filesystem::path& path) noexcept -> Result<std::string> override;
+    /// Views stored entries in place inside mapped archive, inflates other entries
+    auto map(const std::filesystem::path& path) noexcept -> Result<FileView> override;
+
+    [[nodiscard]]
+    auto packed() const noexcept -> bool override {
+        return true;
+    }
+
+    /// Look up entry in index built when archive was opened
+    [[nodiscard]]
+    auto find(const std::filesystem::path& path) const noexcept -> const Entry *;
 
     ZipStore(const ZipStore&) = delete;
     ZipStore(ZipStore&& other) noexcept;
@@ -65,7 +142,10 @@ class ZipStore final: public IFileStore {
     ~ZipStore() override;
 
   private:
-    ZipStore(zip_t *zip);
+    ZipStore(std::unique_ptr<State>&& state) noexcept;
+
+    /// Read entry contents into `out`, which must be sized to `entry.size`
+    auto read_entry(const Entry& entry, std::span<char> out) noexcept -> Result<>;
 };
 
 } // namespace glint
@@ -1,5 +1,8 @@
+#include <charconv>
 #include <span>
+#include <string_view>
 #include <filesystem>
+#include <optional>
 
 #include <fmt/format.h>
 #include <quickjs.h>
@@ -10,7 +13,10 @@
 #include <engine.hpp>
 #include <plugins/core.hpp>
 #include <plugins/audio.hpp>
+#include <plugins/ecs.hpp>
+#include <plugins/worker.hpp>
 #include <file_store.hpp>
+#include <pack.hpp>
 
 #include <glint_config.h>
 
@@ -27,8 +33,38 @@ auto main(int argc, char **argv) noexcept -> int try {
     auto args = std::span(argv, size_t(argc));
 
     auto path_str = args[0];
-    if (argc == 2) {
-        path_str = argv[1];
+    auto run_options = RunOptions {};
+    auto pack_output = std::optional<std::filesystem::path> {};
+    auto first_arg = size_t {1};
+    if (args.size() > 1 && std::string_view(args[1]) == "pack") {
+        // glint pack <game-dir> [output.zip]
+        if (args.size() < 3 || args.size() > 4) {
+            fmt::println(stderr, "Usage: glint pack <game-dir> [output.zip]");
+            return 1;
+        }
+        path_str = args[2];
+        auto game_dir = std::filesystem::path(path_str).lexically_normal();
+        if (!game_dir.has_filename()) game_dir = game_dir.parent_path();
+        pack_output = args.size() == 4 ? std::filesystem::path(args[3]) : game_dir;
+        if (args.size() == 3) *pack_output += ".zip";
+        first_arg = args.size();
+    }
+    for (size_t i = first_arg; i < args.size(); i++) {
+        const auto arg = std::string_view(args[i]);
+        if (arg == "--headless") {
+            run_options.headless = true;
+        } else if (arg == "--frames") {
+            const auto value = i + 1 < args.size() ? std::string_view(args[++i]) : std::string_view {};
+            auto frames = uint64_t {0};
+            const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), frames);
+            if (value.empty() || ec != std::errc {} || end != value.data() + value.size()) {
+                fmt::println(stderr, "Invalid value for --frames: '{}'", value);
+                return 1;
+            }
+            run_options.frames = frames;
+        } else {
+            path_str = args[i];
+        }
     }
 
     const auto path = std::filesystem::path(path_str);
@@ -42,8 +78,19 @@ auto main(int argc, char **argv) noexcept -> int try {
     auto engine = std::move(*engine_result);
 
     SPDLOG_TRACE("Registering plugins");
-    engine->register_plugin(plugins::core::plugin(engine->js_context()));
-    engine->register_plugin(plugins::audio::plugin(engine->js_context()));
+    engine->register_plugin(plugins::core::plugin);
+    engine->register_plugin(plugins::audio::plugin);
+    engine->register_plugin(plugins::ecs::plugin);
+    engine->register_plugin(plugins::worker::plugin);
+
+    if (pack_output) {
+        if (auto r = pack_game(*engine, path, *pack_output); !r) {
+            fmt::println(stderr, "Error packing game: {}", r.error()->msg());
+            if (auto loc = r.error()->loc_str()) fmt::println("Originated from:\n    {}", *loc);
+            return 1;
+        }
+        return 0;
+    }
 
     if (auto r = engine->load_plugins(); !r) {
         fmt::println("Error loading plugins: {}", r.error()->msg());
@@ -59,7 +106,7 @@ auto main(int argc, char **argv) noexcept -> int try {
     }
     auto game = std::move(*game_result);
 
-    const auto run_result = engine->run_game(game);
+    const auto run_result = engine->run_game(game, run_options);
     if (!run_result) {
         fmt::println(stderr, "Error running game: {}", run_result.error()->msg());
         if (auto loc = run_result.error()->loc_str()) fmt::println("Originated from:\n    {}", *loc);
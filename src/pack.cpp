@@ -0,0 +1,129 @@
+#include <pack.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <zip.h>
+
+#include <defer.hpp>
+#include <engine/bytecode.hpp>
+#include <engine/modules.hpp>
+
+namespace glint {
+
+namespace {
+
+/// Formats that are compressed already: deflating them gains nothing and makes them unmappable from archive
+constexpr auto stored_extensions = std::array<std::string_view, 11> {
+    ".png", ".jpg", ".jpeg", ".gif", ".webp", ".qoi", ".ogg", ".mp3", ".flac", ".qoa", ".zip",
+};
+
+auto add_source(zip_t *zip, const std::string& name, zip_source_t *source) noexcept -> Result<zip_uint64_t> {
+    if (source == nullptr) return err(fmt::format("Could not add `{}`: {}", name, zip_strerror(zip)));
+    const auto index = zip_file_add(zip, name.c_str(), source, ZIP_FL_ENC_UTF_8);
+    if (index < 0) {
+        zip_source_free(source);
+        return err(fmt::format("Could not add `{}`: {}", name, zip_strerror(zip)));
+    }
+    return zip_uint64_t(index);
+}
+
+auto is_compressed_format(const std::filesystem::path& path) noexcept -> bool {
+    auto ext = path.extension().string();
+    std::ranges::transform(ext, ext.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    return std::ranges::find(stored_extensions, ext) != stored_extensions.end();
+}
+
+} // namespace
+
+auto pack_game(Engine& engine, const std::filesystem::path& game_dir, const std::filesystem::path& output) noexcept
+    -> Result<> try {
+    auto ec = int {};
+    auto zip = zip_open(output.string().c_str(), ZIP_CREATE | ZIP_TRUNCATE, &ec);
+    if (zip == nullptr) {
+        auto e = zip_error_t {};
+        zip_error_init_with_code(&e, ec);
+        defer(zip_error_fini(&e));
+        return err(fmt::format("Could not create archive `{}`: {}", output.string(), zip_error_strerror(&e)));
+    }
+    auto closed = false;
+    defer(if (!closed) zip_discard(zip));
+
+    const auto ctx = engine.js_context();
+    // libzip reads buffers only when archive is closed, so bytecode must outlive `zip_close`
+    auto bytecodes = std::deque<std::string> {};
+    const auto output_abs = std::filesystem::weakly_canonical(output);
+    auto modules = 0;
+    auto files = 0;
+    for (auto it = std::filesystem::recursive_directory_iterator(game_dir); it != decltype(it) {}; ++it) {
+        const auto& entry = *it;
+        const auto rel = std::filesystem::relative(entry.path(), game_dir);
+        if (entry.is_directory()) {
+            // Skip local caches and VCS metadata
+            if (rel.filename().string().starts_with(".")) it.disable_recursion_pending();
+            continue;
+        }
+        if (!entry.is_regular_file() || std::filesystem::weakly_canonical(entry.path()) == output_abs) continue;
+
+        const auto name = rel.generic_string();
+        if (rel.extension() != ".js") {
+            SPDLOG_DEBUG("Adding {}", name);
+            auto source = zip_source_file(zip, entry.path().string().c_str(), 0, -1);
+            const auto index = add_source(zip, name, source);
+            if (!index) return err(index);
+            // Stored entries are read by ZipStore straight from mapped archive
+            if (is_compressed_format(rel) && zip_set_file_compression(zip, *index, ZIP_CM_STORE, 0) < 0) {
+                return err(fmt::format("Could not set compression of `{}`: {}", name, zip_strerror(zip)));
+            }
+            files++;
+            continue;
+        }
+
+        auto file = std::ifstream {entry.path(), std::ios::in | std::ios::binary};
+        const auto contents = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (file.bad()) return err(fmt::format("Could not read {}", entry.path().string()));
+
+        // Bytecode keeps the name it was compiled under, and the game looks modules up by normalized name
+        const auto module_name = engine::modules::normalize(name);
+        SPDLOG_DEBUG("Compiling {}", module_name);
+        auto mod = JS_Eval(
+            ctx,
+            contents.c_str(),
+            contents.size(),
+            module_name.c_str(),
+            JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY
+        );
+        if (JS_IsException(mod)) return err(js::JSError(js::own(ctx, JS_GetException(ctx))));
+        defer(JS_FreeValue(ctx, mod));
+
+        const auto& bytecode = bytecodes.emplace_back(engine::bytecode::write(ctx, mod));
+        if (bytecode.empty()) return err(fmt::format("Could not serialize {}", module_name));
+
+        auto bytecode_name = rel;
+        bytecode_name.replace_extension(".jsc");
+        auto source = zip_source_buffer(zip, bytecode.data(), bytecode.size(), 0);
+        if (auto r = add_source(zip, bytecode_name.generic_string(), source); !r) return err(r);
+        modules++;
+    }
+
+    closed = true;
+    if (zip_close(zip) < 0) {
+        auto r = err(fmt::format("Could not write archive `{}`: {}", output.string(), zip_strerror(zip)));
+        zip_discard(zip);
+        return r;
+    }
+
+    SPDLOG_INFO("Packed {} modules and {} files into {}", modules, files, output.string());
+    return {};
+} catch (std::exception& e) {
+    return err(e);
+}
+
+} // namespace glint
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <filesystem>
+
+#include <engine.hpp>
+#include <error.hpp>
+
+namespace glint {
+
+/// Write game directory to zip archive at `output`, skipping dot directories and the archive itself.
+/// Every `.js` file is compiled into `.jsc` bytecode next to where it was, under the module name the game
+/// imports it by (see `engine::modules::normalize`), and its source is left out. Other files are copied,
+/// already compressed formats stored as is. Imports are not resolved, engine only provides the JS context
+auto pack_game(Engine& engine, const std::filesystem::path& game_dir, const std::filesystem::path& output) noexcept
+    -> Result<>;
+
+} // namespace glint
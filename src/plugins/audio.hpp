@@ -34,7 +34,8 @@ auto plugin(JSContext *ctx) -> EnginePlugin {
             return {};
         },
 
-        .unload = []() -> Result<> {
+        // Device outlives contexts, so reloading keeps it playing
+        .shutdown = []() -> Result<> {
             engine::audio::close();
             return {};
         },
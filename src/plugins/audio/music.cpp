@@ -32,8 +32,7 @@ auto JSMusic::custom_constructor(JSContext *ctx, JSValueConst this_val, int argc
         return JS_GetException(ctx);
     }
 
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-    auto ptr = new (std::nothrow) JSMusic();
+    auto ptr = JSMusic::allocate();
     ptr->initialize(music);
     JS_SetOpaque(obj, ptr);
 
@@ -43,6 +42,58 @@ auto JSMusic::custom_constructor(JSContext *ctx, JSValueConst this_val, int argc
     return obj;
 }
 
+auto JSMusic::load_async(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+    -> JSValue try {
+    (void)this_val;
+    auto& e = Engine::get(ctx);
+    auto args = unpack_args<std::string>(ctx, argc, argv);
+    if (!args) return jsthrow(args.error());
+    auto promise = Promise::create(ctx);
+    if (!promise) return jsthrow(promise.error());
+
+    struct Job {
+        std::filesystem::path path;
+        FileView file {};
+        std::string error {};
+    };
+    auto job = std::make_shared<Job>(std::get<0>(std::move(*args)));
+
+    engine::loader::submit(
+        e.loader(),
+        {
+            .work =
+                [job, &e] {
+                    // Read rather than mapped, see `music::load`
+                    auto file = e.file_store().read_bytes(job->path);
+                    if (file) job->file = FileView {std::move(*file)};
+                    else job->error = file.error()->msg();
+                },
+            .finish =
+                [job, ctx, promise = std::move(*promise)]() mutable {
+                    if (!job->error.empty()) {
+                        const auto msg = fmt::format("Could not load music {}: {}", job->path.string(), job->error);
+                        promise.reject(JS_NewPlainError(ctx, "%s", msg.c_str()));
+                        return;
+                    }
+                    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
+                    auto music_ptr =
+                        new (std::nothrow) audio::Music {music::from_memory(job->path, std::move(job->file))};
+                    if (music_ptr == nullptr) {
+                        const auto msg = fmt::format("Could not allocate music {}", job->path.string());
+                        promise.reject(JS_NewPlainError(ctx, "%s", msg.c_str()));
+                        return;
+                    }
+                    audio::get().musics.insert(music_ptr);
+                    promise.resolve(create_instance(ctx, music_ptr));
+                },
+        }
+    );
+
+    return promise->value();
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
 auto JSMusic::custom_finalizer(JSRuntime *rt, JSValueConst val) noexcept -> void {
     auto ptr = static_cast<JSMusic *>(JS_GetOpaque(val, JSMusic::class_id(rt)));
     if (ptr == nullptr) {
@@ -51,8 +102,7 @@ auto JSMusic::custom_finalizer(JSRuntime *rt, JSValueConst val) noexcept -> void
     }
 
     audio::get().musics.erase(ptr->_music);
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-    delete ptr;
+    JSMusic::deallocate(ptr);
 };
 
 } // namespace glint::plugins::audio
@@ -56,10 +56,15 @@ class JSMusic: public JSClass<JSMusic> {
 
     static auto custom_finalizer(JSRuntime *rt, JSValueConst val) noexcept -> void;
 
+    /// `Music.load(path)`: reads on loader workers, opens stream on main thread
+    static auto load_async(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept -> JSValue;
+
   public: // JSClass implementation
     constexpr static auto class_name = "Music";
 
-    inline static auto static_properties = PropertyList {};
+    inline static auto static_properties = PropertyList {
+        cfunc_def("load", 1, &JSMusic::load_async),
+    };
 
     inline static auto instance_properties = PropertyList {
         export_get_only<&JSMusic::get_playing>("playing"),
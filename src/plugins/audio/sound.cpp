@@ -35,8 +35,7 @@ auto JSSound::custom_constructor(JSContext *ctx, JSValueConst this_val, int argc
     // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
     auto sound_ptr = new (std::nothrow) audio::Sound {std::move(*sound_result)};
 
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-    auto ptr = new (std::nothrow) JSSound();
+    auto ptr = JSSound::allocate();
 
     ptr->initialize(sound_ptr);
     JS_SetOpaque(obj, ptr);
@@ -46,6 +45,61 @@ auto JSSound::custom_constructor(JSContext *ctx, JSValueConst this_val, int argc
     return obj;
 }
 
+auto JSSound::load_async(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+    -> JSValue try {
+    (void)this_val;
+    auto& e = Engine::get(ctx);
+    auto args = unpack_args<std::string>(ctx, argc, argv);
+    if (!args) return jsthrow(args.error());
+    auto promise = Promise::create(ctx);
+    if (!promise) return jsthrow(promise.error());
+
+    struct Job {
+        std::filesystem::path path;
+        rl::Wave wave {};
+        std::string error {};
+    };
+    auto job = std::make_shared<Job>(std::get<0>(std::move(*args)));
+
+    engine::loader::submit(
+        e.loader(),
+        {
+            .work =
+                [job, &e] {
+                    auto file = e.file_store().map(job->path);
+                    if (!file) {
+                        job->error = file.error()->msg();
+                        return;
+                    }
+                    job->wave = rl::Wave::load_from_memory(job->path.extension().string().c_str(), file->data());
+                    if (!IsWaveValid(job->wave)) job->error = "Unsupported or corrupted audio";
+                },
+            .finish =
+                [job, ctx, promise = std::move(*promise)]() mutable {
+                    if (!job->error.empty()) {
+                        const auto msg = fmt::format("Could not load sound {}: {}", job->path.string(), job->error);
+                        promise.reject(JS_NewPlainError(ctx, "%s", msg.c_str()));
+                        return;
+                    }
+                    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
+                    auto sound_ptr = new (std::nothrow) audio::Sound {sound::from_wave(job->wave)};
+                    job->wave = {};
+                    if (sound_ptr == nullptr) {
+                        const auto msg = fmt::format("Could not allocate sound {}", job->path.string());
+                        promise.reject(JS_NewPlainError(ctx, "%s", msg.c_str()));
+                        return;
+                    }
+                    audio::get().sounds.insert(sound_ptr);
+                    promise.resolve(create_instance(ctx, sound_ptr));
+                },
+        }
+    );
+
+    return promise->value();
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
 auto JSSound::custom_finalizer(JSRuntime *rt, JSValueConst val) noexcept -> void {
     auto ptr = static_cast<JSSound *>(JS_GetOpaque(val, JSSound::class_id(rt)));
     if (ptr == nullptr) {
@@ -55,8 +109,7 @@ auto JSSound::custom_finalizer(JSRuntime *rt, JSValueConst val) noexcept -> void
 
     audio::get().sounds.erase(ptr->_sound);
 
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-    delete ptr;
+    JSSound::deallocate(ptr);
 }
 
 } // namespace glint::plugins::audio
@@ -41,10 +41,15 @@ class JSSound: public JSClass<JSSound> {
 
     static auto custom_finalizer(JSRuntime *rt, JSValueConst val) noexcept -> void;
 
+    /// `Sound.load(path)`: reads and decodes on loader workers, uploads on main thread
+    static auto load_async(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept -> JSValue;
+
   public: // JSClass implementation
     constexpr static auto class_name = "Sound";
 
-    inline static auto static_properties = PropertyList {};
+    inline static auto static_properties = PropertyList {
+        cfunc_def("load", 1, &JSSound::load_async),
+    };
 
     inline static auto instance_properties = PropertyList {
         export_get_only<&JSSound::get_playing>("playing"),
@@ -1,2 +1,4 @@
 #include "core/font.cpp"
+#include "core/particle_emitter.cpp"
 #include "core/texture.cpp"
+#include "core/tile_map.cpp"
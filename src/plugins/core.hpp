@@ -6,16 +6,23 @@
 #include <plugins/core/camera.hpp>
 #include <plugins/core/color.hpp>
 #include <plugins/core/console.hpp>
+#include <plugins/core/culling.hpp>
 #include <plugins/core/font.hpp>
 #include <plugins/core/graphics.hpp>
 #include <plugins/core/keyboard.hpp>
 #include <plugins/core/mouse.hpp>
 #include <plugins/core/npatch.hpp>
+#include <plugins/core/particle_emitter.hpp>
+#include <plugins/core/profiler.hpp>
 #include <plugins/core/rectangle.hpp>
 #include <plugins/core/render_texture.hpp>
 #include <plugins/core/screen.hpp>
+#include <plugins/core/sprite_batch.hpp>
+#include <plugins/core/text_layout.hpp>
 #include <plugins/core/texture.hpp>
+#include <plugins/core/tile_map.hpp>
 #include <plugins/core/vector2.hpp>
+#include <plugins/core/vector2_array.hpp>
 
 static constexpr char CORE_LOAD[] = {
 #include "core_load.js.h"
@@ -36,14 +43,19 @@ auto plugin(JSContext *ctx) -> EnginePlugin {
                 {"@glint/core/Color", color_module(ctx)},
                 {"@glint/core/Font", font_module(ctx)},
                 {"@glint/core/NPatch", npatch_module(ctx)},
+                {"@glint/core/ParticleEmitter", particle_emitter_module(ctx)},
                 {"@glint/core/Rectangle", rectangle_module(ctx)},
                 {"@glint/core/RenderTexture", render_texture_module(ctx)},
+                {"@glint/core/TextLayout", text_layout_module(ctx)},
                 {"@glint/core/Texture", texture_module(ctx)},
+                {"@glint/core/TileMap", tile_map_module(ctx)},
                 {"@glint/core/Vector2", vector2_module(ctx)},
+                {"@glint/core/Vector2Array", vector2_array_module(ctx)},
                 {"@glint/core/console", console_module(ctx)},
                 {"@glint/core/graphics", graphics_module(ctx)},
                 {"@glint/core/keyboard", keyboard_module(ctx)},
                 {"@glint/core/mouse", mouse_module(ctx)},
+                {"@glint/core/profiler", profiler_module(ctx)},
                 {"@glint/core/screen", screen_module(ctx)},
             },
 
@@ -58,10 +70,26 @@ auto plugin(JSContext *ctx) -> EnginePlugin {
             return {};
         },
 
+        .update = [=]() -> Result<> {
+            auto w = Engine::get(ctx).game_window();
+            const auto dt = w != nullptr ? window::frame_time(*w) : GetFrameTime();
+            for (auto emitter : particle_emitters()) {
+                if (emitter->get_auto_update()) emitter->step(dt);
+            }
+            return {};
+        },
+
         .draw = []() -> Result<> {
-            ClearBackground(BLACK);
+            if (IsWindowReady()) ClearBackground(BLACK);
             return {};
-        }
+        },
+
+        .post_draw = [=]() -> Result<> {
+            end_frame(sprite_batch(), Engine::get(ctx).texture_store());
+            end_frame(culling());
+            end_frame(glyph_run_cache());
+            return {};
+        },
     };
 }
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+
 #include <plugins/core/vector2.hpp>
 
 #include <quickjs.hpp>
@@ -48,6 +51,8 @@ class JSCamera: public JSClass<JSCamera> {
   public: // JSClass implementation
     constexpr static auto class_name = "Camera";
 
+    constexpr static bool pooled = true;
+
     inline static auto static_properties = PropertyList {
         export_static_method<&JSCamera::default_camera>("default"),
     };
@@ -71,6 +76,23 @@ class JSCamera: public JSClass<JSCamera> {
     ::Camera2D _camera {};
 };
 
+/// World-space bounds of the area `camera` shows on a `width` x `height` render target, rotation included
+inline auto visible_rect(const ::Camera2D& camera, float width, float height) noexcept -> Rectangle {
+    const auto corners = std::array {
+        GetScreenToWorld2D(Vector2 {.x = 0.0f, .y = 0.0f}, camera),
+        GetScreenToWorld2D(Vector2 {.x = width, .y = 0.0f}, camera),
+        GetScreenToWorld2D(Vector2 {.x = 0.0f, .y = height}, camera),
+        GetScreenToWorld2D(Vector2 {.x = width, .y = height}, camera),
+    };
+    auto min = corners[0];
+    auto max = corners[0];
+    for (const auto& c : corners) {
+        min = Vector2 {.x = std::min(min.x, c.x), .y = std::min(min.y, c.y)};
+        max = Vector2 {.x = std::max(max.x, c.x), .y = std::max(max.y, c.y)};
+    }
+    return Rectangle {.x = min.x, .y = min.y, .width = max.x - min.x, .height = max.y - min.y};
+}
+
 inline auto camera_module(JSContext *ctx) -> JSModuleDef * {
     auto m = JS_NewCModule(ctx, "@glint/core/Camera", [](auto ctx, auto m) -> int {
         auto ctor = JSCamera::define(ctx).take();
@@ -58,6 +58,8 @@ class JSColor: public JSClass<JSColor> {
 
     constexpr static auto class_name = "Color";
 
+    constexpr static bool pooled = true;
+
     inline static auto static_properties = PropertyList {
         export_static_method<&JSColor::from_hex>("fromHex"),
     };
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include <raylib.h>
+
+#include <plugins/core/camera.hpp>
+
+namespace glint::plugins::core {
+
+struct CullStats {
+    /// Draws passed on to raylib
+    size_t submitted = 0;
+    /// Draws dropped for being outside of the camera view
+    size_t culled = 0;
+};
+
+/// Tracks the visible world rectangle while camera mode is active, so draws outside of it are dropped
+/// before they reach rlgl
+struct Culling {
+    bool enabled = true;
+    /// Size of texture being drawn into in texture mode
+    std::optional<Vector2> target_size {};
+    /// World rectangle visible through the active camera
+    std::optional<Rectangle> view {};
+    /// Counters of the frame in progress
+    CullStats frame {};
+    /// Counters of the last finished frame
+    CullStats last_frame {};
+};
+
+/// Culling state of the main thread, the only one that draws
+inline auto culling() noexcept -> Culling& {
+    static auto state = Culling {};
+    return state;
+}
+
+/// Starts culling against the view of `camera` on screen of `screen_size`, or on current texture mode target
+inline auto begin_camera(Culling& self, const ::Camera2D& camera, Vector2 screen_size) noexcept -> void {
+    const auto size = self.target_size.value_or(screen_size);
+    self.view = visible_rect(camera, size.x, size.y);
+}
+
+inline auto end_camera(Culling& self) noexcept -> void {
+    self.view = std::nullopt;
+}
+
+/// `rect` with non-negative size covering the same area. `CheckCollisionRecs` misses rectangles with negative size
+[[nodiscard]] inline auto normalized(const Rectangle& rect) noexcept -> Rectangle {
+    return {
+        .x = std::min(rect.x, rect.x + rect.width),
+        .y = std::min(rect.y, rect.y + rect.height),
+        .width = std::abs(rect.width),
+        .height = std::abs(rect.height),
+    };
+}
+
+/// Counts a draw with world `bounds`, returning false when it can be skipped
+inline auto visible(Culling& self, const Rectangle& bounds) noexcept -> bool {
+    if (self.enabled && self.view && !CheckCollisionRecs(*self.view, normalized(bounds))) {
+        self.frame.culled++;
+        return false;
+    }
+    self.frame.submitted++;
+    return true;
+}
+
+/// Counts a draw that cannot be culled
+inline auto submitted(Culling& self) noexcept -> void {
+    self.frame.submitted++;
+}
+
+/// Bounds of rectangle `dest` rotated by `rotation` degrees around `dest.x, dest.y`, where `origin` is the pivot
+/// relative to the rectangle. Rotated rectangles get the bounds of their circumscribed circle
+[[nodiscard]] inline auto rotated_bounds(const Rectangle& dest, Vector2 origin, float rotation) noexcept
+    -> Rectangle {
+    const auto w = std::abs(dest.width);
+    const auto h = std::abs(dest.height);
+    if (rotation == 0.0f) return {.x = dest.x - origin.x, .y = dest.y - origin.y, .width = w, .height = h};
+
+    const auto dx = std::max(std::abs(origin.x), std::abs(w - origin.x));
+    const auto dy = std::max(std::abs(origin.y), std::abs(h - origin.y));
+    const auto r = std::sqrt(dx * dx + dy * dy);
+    return {.x = dest.x - r, .y = dest.y - r, .width = r * 2.0f, .height = r * 2.0f};
+}
+
+/// Finishes frame counters. raylib resets the transform in `BeginDrawing`, so camera and texture mode left
+/// active by the game do not carry over into the next frame
+inline auto end_frame(Culling& self) noexcept -> void {
+    self.last_frame = self.frame;
+    self.frame = {};
+    self.view = std::nullopt;
+    self.target_size = std::nullopt;
+}
+
+} // namespace glint::plugins::core
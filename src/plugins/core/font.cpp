@@ -40,14 +40,95 @@ auto JSFont::custom_constructor(JSContext *ctx, JSValueConst this_val, int argc,
         return JS_ThrowInternalError(ctx, "Font constructor could not create object");
     }
 
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-    auto ptr = new (std::nothrow) JSFont();
+    auto ptr = JSFont::allocate();
     ptr->initialize(*handle);
     JS_SetOpaque(obj, ptr);
 
     return obj;
 }
 
+auto JSFont::load_async(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+    -> JSValue try {
+    (void)this_val;
+    auto opts = read_font_options_from_args(ctx, argc, argv);
+    if (!opts) return jsthrow(opts.error());
+    auto promise = Promise::create(ctx);
+    if (!promise) return jsthrow(promise.error());
+    auto& e = Engine::get(ctx);
+
+    if (const auto by_name = std::get_if<JSFontLoadByName>(&*opts)) {
+        promise->resolve(create_instance(ctx, e.font_store().load_by_name(by_name->name)));
+        return promise->value();
+    }
+
+    const auto params = std::get_if<JSFontLoadByParams>(&*opts);
+    if (params == nullptr) return jsthrow(JSError::type_error(ctx, "Either name or path must be present in options"));
+
+    if (const auto handle = e.font_store().load_by_name(params->name); handle != 0) {
+        promise->resolve(create_instance(ctx, handle));
+        return promise->value();
+    }
+
+    struct Job {
+        JSFontLoadByParams params;
+        std::optional<FileView> file {};
+        rl::FontAtlas atlas {};
+        std::string error {};
+    };
+    auto job = std::make_shared<Job>(std::move(*params));
+
+    engine::loader::submit(
+        e.loader(),
+        {
+            .work =
+                [job, &e] {
+                    auto file = e.file_store().map(job->params.path);
+                    if (!file) {
+                        job->error = file.error()->msg();
+                        return;
+                    }
+                    std::optional<std::span<int>> codepoints {};
+                    if (job->params.codepoints) codepoints = std::span(*job->params.codepoints);
+                    const auto extension = job->params.path.extension().string();
+                    job->atlas = rl::FontAtlas::rasterize(
+                        extension.c_str(),
+                        file->data(),
+                        job->params.font_size,
+                        codepoints
+                    );
+                    // Formats other than TTF/OTF are parsed on main thread from kept file contents
+                    if (!job->atlas.valid()) job->file = std::move(*file);
+                },
+            .finish =
+                [job, ctx, &e, promise = std::move(*promise)]() mutable {
+                    if (!job->error.empty()) {
+                        const auto msg =
+                            fmt::format("Could not load font {}: {}", job->params.path.string(), job->error);
+                        promise.reject(JS_NewPlainError(ctx, "%s", msg.c_str()));
+                        return;
+                    }
+                    const auto handle = e.font_store().load(job->params.name, [&]() -> FontData {
+                        if (job->atlas.valid()) return {.font = job->atlas.upload(), .name = job->params.path};
+                        std::optional<std::span<int>> codepoints {};
+                        if (job->params.codepoints) codepoints = std::span(*job->params.codepoints);
+                        return FontData::load_from_memory(
+                            job->params.path,
+                            job->file->bytes(),
+                            job->params.font_size,
+                            codepoints
+                        );
+                    });
+                    job->file.reset();
+                    promise.resolve(create_instance(ctx, handle));
+                },
+        }
+    );
+
+    return promise->value();
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
 auto JSFont::custom_finalizer(JSRuntime *rt, JSValueConst val) noexcept -> void {
     auto ptr = static_cast<JSFont *>(JS_GetOpaque(val, JSFont::class_id(rt)));
     if (ptr == nullptr) {
@@ -57,8 +138,7 @@ auto JSFont::custom_finalizer(JSRuntime *rt, JSValueConst val) noexcept -> void
 
     auto& e = Engine::get(rt);
     e.font_store().release(ptr->_handle);
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-    delete ptr;
+    JSFont::deallocate(ptr);
 }
 
 auto JSFont::read_font_options_from_args(JSContext *ctx, int argc, JSValueConst *argv) noexcept
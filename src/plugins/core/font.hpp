@@ -58,10 +58,15 @@ class JSFont: public JSClass<JSFont> {
     static auto read_font_options_from_args(JSContext *ctx, int argc, JSValueConst *argv) noexcept
         -> JSResult<JSFontLoadMode>;
 
+    /// `Font.load(path | options)`: reads and rasterizes on loader workers, uploads atlas on main thread
+    static auto load_async(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept -> JSValue;
+
   public: // JSClass implementation
     constexpr static auto class_name = "Font";
 
-    constexpr static auto static_properties = PropertyList {};
+    inline static auto static_properties = PropertyList {
+        cfunc_def("load", 1, &JSFont::load_async),
+    };
 
     inline static auto instance_properties = PropertyList {
         export_get_only<&JSFont::get_valid>("valid"),
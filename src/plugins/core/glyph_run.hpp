@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <raylib.h>
+#include <rlgl.h>
+
+namespace glint::plugins::core {
+
+/// Vertical gap between lines, raylib's default text line spacing
+constexpr auto text_line_spacing = 2.0f;
+
+/// Glyph quad of a shaped string
+struct GlyphQuad {
+    /// Glyph rectangle in font atlas, including padding
+    Rectangle source {};
+    /// Quad relative to top left corner of the text
+    Rectangle dest {};
+};
+
+/// String laid out against a font once: glyph lookup, advances and line breaks are resolved, so drawing it
+/// is one textured quad per visible glyph
+struct GlyphRun {
+    std::vector<GlyphQuad> quads {};
+    /// Same as `MeasureTextEx`
+    Vector2 size {};
+};
+
+/// Identifies a loaded font. Glyph quads stay valid only as long as its atlas does
+struct FontKey {
+    unsigned int texture = 0;
+    const Rectangle *recs = nullptr;
+
+    auto operator==(const FontKey&) const noexcept -> bool = default;
+};
+
+[[nodiscard]] inline auto font_key(const ::Font& font) noexcept -> FontKey {
+    return {.texture = font.texture.id, .recs = font.recs};
+}
+
+/// Lays out UTF-8 `text` the way `DrawTextEx` does
+[[nodiscard]] inline auto shape(const ::Font& font, const std::string& text, float font_size, float spacing) noexcept
+    -> GlyphRun {
+    auto run = GlyphRun {};
+    if (font.glyphs == nullptr || font.recs == nullptr || font.baseSize == 0) return run;
+
+    const auto scale = font_size / float(font.baseSize);
+    const auto padding = float(font.glyphPadding);
+    auto x = 0.0f;
+    auto y = 0.0f;
+    auto width = 0.0f;
+    auto line_width = 0.0f;
+    auto height = text.empty() ? 0.0f : font_size;
+    run.quads.reserve(text.size());
+
+    for (size_t i = 0; i < text.size();) {
+        auto bytes = 0;
+        const auto codepoint = GetCodepointNext(text.c_str() + i, &bytes);
+        i += size_t(std::max(bytes, 1));
+
+        if (codepoint == '\n') {
+            width = std::max(width, line_width);
+            line_width = 0.0f;
+            x = 0.0f;
+            y += font_size + text_line_spacing;
+            height += font_size + text_line_spacing;
+            continue;
+        }
+
+        const auto index = GetGlyphIndex(font, codepoint);
+        const auto& glyph = font.glyphs[index];
+        const auto& rec = font.recs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            run.quads.push_back(GlyphQuad {
+                .source = {
+                    .x = rec.x - padding,
+                    .y = rec.y - padding,
+                    .width = rec.width + 2.0f * padding,
+                    .height = rec.height + 2.0f * padding,
+                },
+                .dest = {
+                    .x = x + (float(glyph.offsetX) - padding) * scale,
+                    .y = y + (float(glyph.offsetY) - padding) * scale,
+                    .width = (rec.width + 2.0f * padding) * scale,
+                    .height = (rec.height + 2.0f * padding) * scale,
+                },
+            });
+        }
+        const auto advance = (glyph.advanceX != 0 ? float(glyph.advanceX) : rec.width) * scale;
+        line_width = x + advance;
+        x += advance + spacing;
+    }
+
+    run.size = {.x = std::max(width, line_width), .y = height};
+    return run;
+}
+
+/// Draws `run` shaped against `font` with its top left corner at `position - origin`, rotated around `position`
+inline auto draw(const GlyphRun& run, const ::Font& font, Vector2 position, Vector2 origin, float rotation, Color tint)
+    -> void {
+    if (rotation == 0.0f) {
+        const auto x = position.x - origin.x;
+        const auto y = position.y - origin.y;
+        for (const auto& q : run.quads) {
+            const auto dest =
+                Rectangle {.x = x + q.dest.x, .y = y + q.dest.y, .width = q.dest.width, .height = q.dest.height};
+            DrawTexturePro(font.texture, q.source, dest, Vector2 {}, 0.0f, tint);
+        }
+        return;
+    }
+
+    rlPushMatrix();
+    rlTranslatef(position.x, position.y, 0.0f);
+    rlRotatef(rotation, 0.0f, 0.0f, 1.0f);
+    rlTranslatef(-origin.x, -origin.y, 0.0f);
+    for (const auto& q : run.quads) {
+        DrawTexturePro(font.texture, q.source, q.dest, Vector2 {}, 0.0f, tint);
+    }
+    rlPopMatrix();
+}
+
+struct GlyphRunCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+/// Runs of strings drawn recently, keyed by font, size, spacing and text, so unchanged labels are not
+/// laid out again every frame
+struct GlyphRunCache {
+    struct Key {
+        FontKey font {};
+        float font_size = 0.0f;
+        float spacing = 0.0f;
+        std::string text {};
+    };
+
+    /// Key of a lookup, does not copy the text
+    struct KeyView {
+        FontKey font {};
+        float font_size = 0.0f;
+        float spacing = 0.0f;
+        std::string_view text {};
+    };
+
+    struct Hash {
+        using is_transparent = void;
+
+        auto operator()(const KeyView& k) const noexcept -> size_t {
+            auto h = std::hash<std::string_view> {}(k.text);
+            h ^= std::hash<unsigned int> {}(k.font.texture) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<float> {}(k.font_size) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<float> {}(k.spacing) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+
+        auto operator()(const Key& k) const noexcept -> size_t {
+            return (*this)(KeyView {.font = k.font, .font_size = k.font_size, .spacing = k.spacing, .text = k.text});
+        }
+    };
+
+    struct Equal {
+        using is_transparent = void;
+
+        static auto view(const Key& k) noexcept -> KeyView {
+            return {.font = k.font, .font_size = k.font_size, .spacing = k.spacing, .text = k.text};
+        }
+
+        static auto view(const KeyView& k) noexcept -> KeyView { return k; }
+
+        auto operator()(const auto& a, const auto& b) const noexcept -> bool {
+            const auto x = view(a);
+            const auto y = view(b);
+            return x.font == y.font && x.font_size == y.font_size && x.spacing == y.spacing && x.text == y.text;
+        }
+    };
+
+    struct Entry {
+        GlyphRun run {};
+        uint64_t last_used = 0;
+    };
+
+    std::unordered_map<Key, Entry, Hash, Equal> runs {};
+    /// Past this many runs, the ones not drawn during the last frame are dropped
+    size_t capacity = 1024;
+    uint64_t frame = 0;
+    /// Counters of the frame in progress
+    GlyphRunCacheStats frame_stats {};
+    /// Counters of the last finished frame
+    GlyphRunCacheStats last_frame {};
+};
+
+/// Cache of the main thread, the only one that draws
+inline auto glyph_run_cache() noexcept -> GlyphRunCache& {
+    static auto cache = GlyphRunCache {};
+    return cache;
+}
+
+/// Run of `text` from cache, shaping it on miss
+inline auto lookup(GlyphRunCache& self, const ::Font& font, const std::string& text, float font_size, float spacing)
+    -> const GlyphRun& {
+    const auto key = GlyphRunCache::KeyView {
+        .font = font_key(font),
+        .font_size = font_size,
+        .spacing = spacing,
+        .text = text,
+    };
+    if (auto it = self.runs.find(key); it != self.runs.end()) {
+        self.frame_stats.hits++;
+        it->second.last_used = self.frame;
+        return it->second.run;
+    }
+
+    self.frame_stats.misses++;
+    auto owned = GlyphRunCache::Key {
+        .font = key.font,
+        .font_size = font_size,
+        .spacing = spacing,
+        .text = text,
+    };
+    auto entry = GlyphRunCache::Entry {.run = shape(font, text, font_size, spacing), .last_used = self.frame};
+    return self.runs.emplace(std::move(owned), std::move(entry)).first->second.run;
+}
+
+/// Drops runs not drawn this frame once the cache is over capacity and starts counting the next frame
+inline auto end_frame(GlyphRunCache& self) noexcept -> void {
+    if (self.runs.size() > self.capacity) {
+        std::erase_if(self.runs, [&](const auto& item) { return item.second.last_used < self.frame; });
+    }
+    self.frame++;
+    self.last_frame = self.frame_stats;
+    self.frame_stats = {};
+}
+
+} // namespace glint::plugins::core
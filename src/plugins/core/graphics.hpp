@@ -1,12 +1,18 @@
 #pragma once
 
-#include <variant>
 #include <optional>
+#include <span>
+#include <variant>
 
 #include <raylib.h>
 #include <spdlog/spdlog.h>
 
 #include <defer.hpp>
+#include <plugins/core/culling.hpp>
+#include <plugins/core/glyph_run.hpp>
+#include <plugins/core/sprite_batch.hpp>
+#include <plugins/core/text_layout.hpp>
+#include <plugins/core/texture.hpp>
 #include <plugins/core/vector2.hpp>
 #include <quickjs.hpp>
 #include <raylib.hpp>
@@ -61,6 +67,33 @@ auto convert_from_js<JSText>(const Value& val) noexcept -> JSResult<JSText> {
     return text;
 }
 
+/// Colors of a batched draw call: either packed RGBA bytes per primitive or one color for all of them
+struct JSBatchColors {
+    std::span<const uint8_t> rgba = {};
+    Color uniform = {};
+
+    [[nodiscard]] auto packed() const noexcept -> bool { return rgba.data() != nullptr; }
+
+    [[nodiscard]] auto at(size_t i) const noexcept -> Color {
+        if (!packed()) return uniform;
+        const auto c = rgba.subspan(i * 4, 4);
+        return Color {.r = c[0], .g = c[1], .b = c[2], .a = c[3]};
+    }
+};
+
+template<>
+inline auto convert_from_js<JSBatchColors>(const Value& val) noexcept -> JSResult<JSBatchColors> {
+    if (JS_GetTypedArrayType(val.cget()) >= 0) {
+        auto rgba = convert_from_js<std::span<const uint8_t>>(val);
+        if (!rgba) return rgba.error();
+        return JSBatchColors {.rgba = *rgba};
+    }
+
+    auto color = convert_from_js<Color>(val);
+    if (!color) return color.error();
+    return JSBatchColors {.uniform = *color};
+}
+
 } // namespace glint::js
 
 namespace glint::plugins::core {
@@ -68,37 +101,132 @@ namespace glint::plugins::core {
 using namespace js;
 
 class JSGraphics: public JSClass<JSGraphics> {
+  private:
+    /// Validates packed batch buffers and returns number of primitives in the batch
+    static auto batch_count(JSContext *ctx, size_t data_size, size_t stride, const JSBatchColors& colors) noexcept
+        -> JSResult<size_t> {
+        if (data_size % stride != 0) {
+            return JSError::range_error(
+                ctx,
+                fmt::format("Batch data length {} is not a multiple of {}", data_size, stride)
+            );
+        }
+
+        const auto count = data_size / stride;
+        if (colors.packed() && colors.rgba.size() < count * 4) {
+            return JSError::range_error(
+                ctx,
+                fmt::format("Batch of {} primitives needs {} color bytes, got {}", count, count * 4, colors.rgba.size())
+            );
+        }
+
+        return count;
+    }
+
+    /// Runs raylib calls of `draw` and returns `this` for chaining. Without a window, as when headless,
+    /// arguments are still validated and culled but nothing is drawn
+    template<typename F>
+    static auto draw_call(JSContext *ctx, JSValueConst this_val, F&& draw) noexcept -> JSValue {
+        if (IsWindowReady()) draw();
+        return JS_DupValue(ctx, this_val);
+    }
+
+    static auto flush_sprites(JSContext *ctx) noexcept -> void {
+        flush(sprite_batch(), Engine::get(ctx).texture_store());
+    }
+
+    static auto screen_size(JSContext *ctx) noexcept -> Vector2 {
+        const auto w = Engine::get(ctx).game_window();
+        if (w == nullptr) return {.x = float(GetScreenWidth()), .y = float(GetScreenHeight())};
+        return {.x = float(window::width(*w)), .y = float(window::height(*w))};
+    }
+
+    /// Draws cached run of `text`. Its size comes with the run, so culling costs no measuring
+    static auto draw_text_run(
+        const ::Font& font,
+        const std::string& text,
+        Vector2 position,
+        Vector2 origin,
+        float rotation,
+        float font_size,
+        float spacing,
+        Color color
+    ) noexcept -> void {
+        const auto& run = lookup(glyph_run_cache(), font, text, font_size, spacing);
+        const auto bounds = Rectangle {.x = position.x, .y = position.y, .width = run.size.x, .height = run.size.y};
+        if (!visible(culling(), rotated_bounds(bounds, origin, rotation))) return;
+        draw(run, font, position, origin, rotation, color);
+    }
+
   public:
     auto clear(JSContext *ctx, JSValueConst this_val, Color color) noexcept -> JSValue {
         SPDLOG_TRACE("ClearBackground({})", color);
-        ClearBackground(color);
-        return JS_DupValue(ctx, this_val);
+        flush_sprites(ctx);
+        return draw_call(ctx, this_val, [&] { ClearBackground(color); });
     }
 
     auto circle(JSContext *ctx, JSValueConst this_val, int x, int y, float radius, Color color) noexcept -> JSValue {
         SPDLOG_TRACE("DrawCircle({}, {}, {}, {})", x, y, radius, color);
-        DrawCircle(x, y, radius, color);
-        return JS_DupValue(ctx, this_val);
+        const auto r = radius;
+        if (!visible(culling(), {.x = float(x) - r, .y = float(y) - r, .width = r * 2.0f, .height = r * 2.0f})) {
+            return JS_DupValue(ctx, this_val);
+        }
+        return draw_call(ctx, this_val, [&] { DrawCircle(x, y, radius, color); });
+    }
+
+    /// Draws circles packed as `[x, y, radius]` triples
+    auto circles(JSContext *ctx, JSValueConst this_val, std::span<const float> data, JSBatchColors colors) noexcept
+        -> JSValue {
+        const auto count = batch_count(ctx, data.size(), 3, colors);
+        if (!count) return jsthrow(count.error());
+        SPDLOG_TRACE("DrawCircleV x {}", *count);
+        return draw_call(ctx, this_val, [&] {
+            for (size_t i = 0; i < *count; i++) {
+                const auto c = data.subspan(i * 3, 3);
+                const auto r = c[2];
+                const auto bounds = Rectangle {.x = c[0] - r, .y = c[1] - r, .width = r * 2.0f, .height = r * 2.0f};
+                if (!visible(culling(), bounds)) continue;
+                DrawCircleV(Vector2 {.x = c[0], .y = c[1]}, c[2], colors.at(i));
+            }
+        });
+    }
+
+    /// Draws rectangles packed as `[x, y, width, height]` quadruples
+    auto rectangles(JSContext *ctx, JSValueConst this_val, std::span<const float> data, JSBatchColors colors) noexcept
+        -> JSValue {
+        const auto count = batch_count(ctx, data.size(), 4, colors);
+        if (!count) return jsthrow(count.error());
+        SPDLOG_TRACE("DrawRectangleRec x {}", *count);
+        return draw_call(ctx, this_val, [&] {
+            for (size_t i = 0; i < *count; i++) {
+                const auto r = data.subspan(i * 4, 4);
+                const auto rec = Rectangle {.x = r[0], .y = r[1], .width = r[2], .height = r[3]};
+                if (!visible(culling(), rec)) continue;
+                DrawRectangleRec(rec, colors.at(i));
+            }
+        });
     }
 
     auto rectangle(JSContext *ctx, JSValueConst this_val, int x, int y, int width, int height, Color color) noexcept
         -> JSValue {
         SPDLOG_TRACE("DrawRectangle({}, {}, {}, {}, {})", x, y, width, height, color);
-        DrawRectangle(x, y, width, height, color);
-        return JS_DupValue(ctx, this_val);
+        const auto bounds = Rectangle {.x = float(x), .y = float(y), .width = float(width), .height = float(height)};
+        if (!visible(culling(), bounds)) return JS_DupValue(ctx, this_val);
+        return draw_call(ctx, this_val, [&] { DrawRectangle(x, y, width, height, color); });
     }
 
     auto rectangle_v(JSContext *ctx, JSValueConst this_val, Vector2 position, Vector2 size, Color color) noexcept
         -> JSValue {
         SPDLOG_TRACE("DrawRectangleV({}, {}, {})", position, size, color);
-        DrawRectangleV(position, size, color);
-        return JS_DupValue(ctx, this_val);
+        const auto bounds = Rectangle {.x = position.x, .y = position.y, .width = size.x, .height = size.y};
+        if (!visible(culling(), bounds)) return JS_DupValue(ctx, this_val);
+        return draw_call(ctx, this_val, [&] { DrawRectangleV(position, size, color); });
     }
 
     auto rectangle_rec(JSContext *ctx, JSValueConst this_val, Rectangle rec, Color color) noexcept -> JSValue {
         SPDLOG_TRACE("DrawRectangleRec({}, {})", rec, color);
-        DrawRectangleRec(rec, color);
-        return JS_DupValue(ctx, this_val);
+        if (!visible(culling(), rec)) return JS_DupValue(ctx, this_val);
+        return draw_call(ctx, this_val, [&] { DrawRectangleRec(rec, color); });
     }
 
     auto rectangle_pro(
@@ -110,99 +238,230 @@ class JSGraphics: public JSClass<JSGraphics> {
         Color color
     ) noexcept -> JSValue {
         SPDLOG_TRACE("DrawRectanglePro({}, {}, {}, {})", rec, origin, rotation, color);
-        DrawRectanglePro(rec, origin, rotation, color);
-        return JS_DupValue(ctx, this_val);
+        if (!visible(culling(), rotated_bounds(rec, origin, rotation))) return JS_DupValue(ctx, this_val);
+        return draw_call(ctx, this_val, [&] { DrawRectanglePro(rec, origin, rotation, color); });
     }
 
     auto begin_camera_mode(JSContext *ctx, JSValueConst this_val, Camera2D camera) noexcept -> JSValue {
         SPDLOG_TRACE("BeginMode2D({})", camera);
-        BeginMode2D(camera);
-        return JS_DupValue(ctx, this_val);
+        flush_sprites(ctx);
+        begin_camera(culling(), camera, screen_size(ctx));
+        return draw_call(ctx, this_val, [&] { BeginMode2D(camera); });
     }
 
     auto end_camera_mode(JSContext *ctx, JSValueConst this_val) noexcept -> JSValue {
         SPDLOG_TRACE("EndMode2D()");
-        EndMode2D();
-        return JS_DupValue(ctx, this_val);
+        flush_sprites(ctx);
+        end_camera(culling());
+        return draw_call(ctx, this_val, [&] { EndMode2D(); });
     }
 
-    auto texture(JSContext *ctx, JSValueConst this_val, const rl::Texture *texture, int x, int y, Color tint) noexcept
+    // Textures may be regions of an atlas page, so every draw goes through the region's source rectangle
+
+    auto texture(JSContext *ctx, JSValueConst this_val, TextureRegion texture, int x, int y, Color tint) noexcept
         -> JSValue {
-        SPDLOG_TRACE("DrawTexture({}, {}, {}, {})", *texture, x, y, tint);
-        DrawTexture(*texture, x, y, tint);
-        return JS_DupValue(ctx, this_val);
+        SPDLOG_TRACE("DrawTexture({}, {}, {}, {})", *texture.texture, x, y, tint);
+        const auto bounds =
+            Rectangle {.x = float(x), .y = float(y), .width = texture.rect.width, .height = texture.rect.height};
+        if (!visible(culling(), bounds)) return JS_DupValue(ctx, this_val);
+        return draw_call(ctx, this_val, [&] {
+            DrawTextureRec(*texture.texture, texture.rect, Vector2 {.x = float(x), .y = float(y)}, tint);
+        });
     }
 
-    auto
-    texture_v(JSContext *ctx, JSValueConst this_val, const rl::Texture *texture, Vector2 position, Color tint) noexcept
+    /// Draws one texture at every position packed as `[x, y]` pairs
+    auto textures(
+        JSContext *ctx,
+        JSValueConst this_val,
+        TextureRegion texture,
+        std::span<const float> positions,
+        JSBatchColors tints
+    ) noexcept -> JSValue {
+        const auto count = batch_count(ctx, positions.size(), 2, tints);
+        if (!count) return jsthrow(count.error());
+        SPDLOG_TRACE("DrawTextureV({}) x {}", *texture.texture, *count);
+        return draw_call(ctx, this_val, [&] {
+            for (size_t i = 0; i < *count; i++) {
+                const auto p = positions.subspan(i * 2, 2);
+                const auto bounds =
+                    Rectangle {.x = p[0], .y = p[1], .width = texture.rect.width, .height = texture.rect.height};
+                if (!visible(culling(), bounds)) continue;
+                DrawTextureRec(*texture.texture, texture.rect, Vector2 {.x = p[0], .y = p[1]}, tints.at(i));
+            }
+        });
+    }
+
+    auto texture_v(JSContext *ctx, JSValueConst this_val, TextureRegion texture, Vector2 position, Color tint) noexcept
         -> JSValue {
-        SPDLOG_TRACE("DrawTextureV({}, {}, {})", *texture, position, tint);
-        DrawTextureV(*texture, position, tint);
-        return JS_DupValue(ctx, this_val);
+        SPDLOG_TRACE("DrawTextureV({}, {}, {})", *texture.texture, position, tint);
+        const auto bounds =
+            Rectangle {.x = position.x, .y = position.y, .width = texture.rect.width, .height = texture.rect.height};
+        if (!visible(culling(), bounds)) return JS_DupValue(ctx, this_val);
+        return draw_call(ctx, this_val, [&] { DrawTextureRec(*texture.texture, texture.rect, position, tint); });
     }
 
     auto texture_ex(
         JSContext *ctx,
         JSValueConst this_val,
-        const rl::Texture *texture,
+        TextureRegion texture,
         Vector2 position,
         float rotation,
         float scale,
         Color tint
     ) noexcept -> JSValue {
-        SPDLOG_TRACE("DrawTextureEx({}, {}, {}, {}, {})", *texture, position, rotation, scale, tint);
-        DrawTextureEx(*texture, position, rotation, scale, tint);
-        return JS_DupValue(ctx, this_val);
+        SPDLOG_TRACE("DrawTextureEx({}, {}, {}, {}, {})", *texture.texture, position, rotation, scale, tint);
+        const auto dest = Rectangle {
+            .x = position.x,
+            .y = position.y,
+            .width = texture.rect.width * scale,
+            .height = texture.rect.height * scale,
+        };
+        if (!visible(culling(), rotated_bounds(dest, Vector2 {}, rotation))) return JS_DupValue(ctx, this_val);
+        return draw_call(ctx, this_val, [&] {
+            DrawTexturePro(*texture.texture, texture.rect, dest, Vector2 {}, rotation, tint);
+        });
     }
 
     auto texture_rec(
         JSContext *ctx,
         JSValueConst this_val,
-        const rl::Texture *texture,
+        TextureRegion texture,
         Rectangle source,
         Vector2 position,
         Color tint
     ) noexcept -> JSValue {
-        SPDLOG_TRACE("DrawTextureRec({}, {}, {}, {})", *texture, source, position, tint);
-        DrawTextureRec(*texture, source, position, tint);
-        return JS_DupValue(ctx, this_val);
+        SPDLOG_TRACE("DrawTextureRec({}, {}, {}, {})", *texture.texture, source, position, tint);
+        const auto bounds =
+            Rectangle {.x = position.x, .y = position.y, .width = source.width, .height = source.height};
+        if (!visible(culling(), rotated_bounds(bounds, Vector2 {}, 0.0f))) return JS_DupValue(ctx, this_val);
+        return draw_call(ctx, this_val, [&] { DrawTextureRec(*texture.texture, texture.map(source), position, tint); });
     }
 
     auto texture_pro(
         JSContext *ctx,
         JSValueConst this_val,
-        const rl::Texture *texture,
+        TextureRegion texture,
         Rectangle source,
         Rectangle dest,
         Vector2 origin,
         float rotation,
         Color tint
     ) noexcept -> JSValue {
-        SPDLOG_TRACE("DrawTexturePro({}, {}, {}, {}, {}, {})", *texture, source, dest, origin, rotation, tint);
-        DrawTexturePro(*texture, source, dest, origin, rotation, tint);
-        return JS_DupValue(ctx, this_val);
+        SPDLOG_TRACE("DrawTexturePro({}, {}, {}, {}, {}, {})", *texture.texture, source, dest, origin, rotation, tint);
+        if (!visible(culling(), rotated_bounds(dest, origin, rotation))) return JS_DupValue(ctx, this_val);
+        return draw_call(ctx, this_val, [&] {
+            DrawTexturePro(*texture.texture, texture.map(source), dest, origin, rotation, tint);
+        });
     }
 
     auto texture_npatch(
         JSContext *ctx,
         JSValueConst this_val,
-        const rl::Texture *texture,
+        TextureRegion texture,
         NPatchInfo npatch,
         Rectangle dest,
         Vector2 origin,
         float rotation,
         Color tint
     ) noexcept -> JSValue {
-        SPDLOG_TRACE("DrawTextureNPatch({}, {}, {}, {}, {}, {});", *texture, npatch, dest, origin, rotation, tint);
-        DrawTextureNPatch(*texture, npatch, dest, origin, rotation, tint);
+        SPDLOG_TRACE(
+            "DrawTextureNPatch({}, {}, {}, {}, {}, {});",
+            *texture.texture,
+            npatch,
+            dest,
+            origin,
+            rotation,
+            tint
+        );
+        if (!visible(culling(), rotated_bounds(dest, origin, rotation))) return JS_DupValue(ctx, this_val);
+        return draw_call(ctx, this_val, [&] {
+            npatch.source = texture.map(npatch.source);
+            DrawTextureNPatch(*texture.texture, npatch, dest, origin, rotation, tint);
+        });
+    }
+
+    /// Records textured quad drawn on the next flush, batched with other sprites of the same layer and texture
+    auto sprite(
+        JSContext *ctx,
+        JSValueConst this_val,
+        JSTexture *texture,
+        Rectangle source,
+        Rectangle dest,
+        std::optional<Color> tint,
+        std::optional<int> layer,
+        std::optional<float> rotation,
+        std::optional<Vector2> origin
+    ) noexcept -> JSValue try {
+        if (!visible(culling(), rotated_bounds(dest, origin.value_or(Vector2 {}), rotation.value_or(0.0f)))) {
+            return JS_DupValue(ctx, this_val);
+        }
+        auto& textures = Engine::get(ctx).texture_store();
+        const auto region = texture->get_region(ctx);
+        auto& batch = sprite_batch();
+        batch.sprites.push_back(Sprite {
+            .layer = layer.value_or(0),
+            .blend = batch.blend,
+            .handle = texture->handle(),
+            .texture = textures.borrow(texture->handle()),
+            .source = region.map(source),
+            .dest = dest,
+            .origin = origin.value_or(Vector2 {}),
+            .rotation = rotation.value_or(0.0f),
+            .tint = tint.value_or(WHITE),
+        });
+        // Reference released by flush
+        textures.get(texture->handle());
+        return JS_DupValue(ctx, this_val);
+    } catch (std::exception& e) {
+        return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+    }
+
+    /// Draws recorded sprites now
+    auto flush_batch(JSContext *ctx, JSValueConst this_val) noexcept -> JSValue {
+        SPDLOG_TRACE("Flushing {} sprites", sprite_batch().sprites.size());
+        flush_sprites(ctx);
         return JS_DupValue(ctx, this_val);
     }
 
+    [[nodiscard]] auto get_blend_mode() const noexcept -> int { return sprite_batch().blend; }
+
+    auto set_blend_mode(int mode) noexcept -> void { sprite_batch().blend = mode; }
+
+    /// Sprite batch counters of the last finished frame
+    [[nodiscard]] auto get_sprite_stats(JSContext *ctx) const noexcept -> JSValue {
+        const auto& stats = sprite_batch().last_frame;
+        auto obj = JS_NewObject(ctx);
+        JS_SetPropertyStr(ctx, obj, "sprites", JS_NewInt64(ctx, int64_t(stats.sprites)));
+        JS_SetPropertyStr(ctx, obj, "drawCalls", JS_NewInt64(ctx, int64_t(stats.draw_calls)));
+        JS_SetPropertyStr(ctx, obj, "textureSwitches", JS_NewInt64(ctx, int64_t(stats.texture_switches)));
+        return obj;
+    }
+
+    [[nodiscard]] auto get_culling() const noexcept -> bool { return culling().enabled; }
+
+    auto set_culling(bool enabled) noexcept -> void { culling().enabled = enabled; }
+
+    /// Culling counters of the last finished frame
+    [[nodiscard]] auto get_cull_stats(JSContext *ctx) const noexcept -> JSValue {
+        const auto& stats = culling().last_frame;
+        auto obj = JS_NewObject(ctx);
+        JS_SetPropertyStr(ctx, obj, "submitted", JS_NewInt64(ctx, int64_t(stats.submitted)));
+        JS_SetPropertyStr(ctx, obj, "culled", JS_NewInt64(ctx, int64_t(stats.culled)));
+        return obj;
+    }
+
     auto
     text(JSContext *ctx, JSValueConst this_val, std::string text, int x, int y, int font_size, Color color) noexcept
         -> JSValue {
         SPDLOG_TRACE("DrawText('{}', {}, {}, {}, {})", text, x, y, font_size, color);
-        DrawText(text.c_str(), x, y, font_size, color);
+        if (!IsWindowReady()) {
+            submitted(culling());
+            return JS_DupValue(ctx, this_val);
+        }
+        // Same size and spacing as `DrawText`
+        const auto size = std::max(font_size, 10);
+        const auto position = Vector2 {.x = float(x), .y = float(y)};
+        draw_text_run(GetFontDefault(), text, position, Vector2 {}, 0.0f, float(size), float(size / 10), color);
         return JS_DupValue(ctx, this_val);
     }
 
@@ -213,13 +472,21 @@ class JSGraphics: public JSClass<JSGraphics> {
         const auto origin = text.origin.value_or(Vector2 {});
         const auto rotation = text.rotation.value_or(0);
         const auto spacing = text.spacing.value_or(0);
+        if (!IsWindowReady()) {
+            submitted(culling());
+            return JS_DupValue(ctx, this_val);
+        }
         auto font = GetFontDefault();
         if (text.font) font = ::Font {**text.font};
 
         if (const auto str = std::get_if<std::string>(&text.text)) {
             SPDLOG_TRACE("DrawTextPro({}, '{}', {}, {}, {})", font, *str, position, font_size, color);
-            DrawTextPro(font, str->c_str(), position, origin, rotation, font_size, spacing, color);
-        } else if (const auto codepoint = std::get_if<int>(&text.text)) {
+            draw_text_run(font, *str, position, origin, rotation, font_size, spacing, color);
+            return JS_DupValue(ctx, this_val);
+        }
+
+        submitted(culling());
+        if (const auto codepoint = std::get_if<int>(&text.text)) {
             SPDLOG_TRACE("DrawTextCodepoint(font, {}, {}, {}, {})", font, *codepoint, position, font_size, color);
             DrawTextCodepoint(font, *codepoint, position, font_size, color);
         } else if (const auto codepoints = std::get_if<std::vector<int>>(&text.text)) {
@@ -237,27 +504,69 @@ class JSGraphics: public JSClass<JSGraphics> {
         return JS_DupValue(ctx, this_val);
     }
 
+    /// Draws prepared `layout`, its top left corner at `position - origin`, rotated around `position`
+    auto text_layout(
+        JSContext *ctx,
+        JSValueConst this_val,
+        JSTextLayout *layout,
+        Vector2 position,
+        Color color,
+        std::optional<float> rotation,
+        std::optional<Vector2> origin
+    ) noexcept -> JSValue {
+        SPDLOG_TRACE("Drawing {} at {}", layout->to_string(), position);
+        if (!IsWindowReady()) {
+            submitted(culling());
+            return JS_DupValue(ctx, this_val);
+        }
+        const auto font = layout->font(ctx);
+        const auto& run = layout->run(ctx);
+        const auto bounds = Rectangle {.x = position.x, .y = position.y, .width = run.size.x, .height = run.size.y};
+        if (!visible(culling(), rotated_bounds(bounds, origin.value_or(Vector2 {}), rotation.value_or(0.0f)))) {
+            return JS_DupValue(ctx, this_val);
+        }
+        draw(run, font, position, origin.value_or(Vector2 {}), rotation.value_or(0.0f), color);
+        return JS_DupValue(ctx, this_val);
+    }
+
+    /// Glyph run cache counters of the last finished frame
+    [[nodiscard]] auto get_text_cache_stats(JSContext *ctx) const noexcept -> JSValue {
+        const auto& cache = glyph_run_cache();
+        auto obj = JS_NewObject(ctx);
+        JS_SetPropertyStr(ctx, obj, "hits", JS_NewInt64(ctx, int64_t(cache.last_frame.hits)));
+        JS_SetPropertyStr(ctx, obj, "misses", JS_NewInt64(ctx, int64_t(cache.last_frame.misses)));
+        JS_SetPropertyStr(ctx, obj, "runs", JS_NewInt64(ctx, int64_t(cache.runs.size())));
+        return obj;
+    }
+
     auto begin_texture_mode(JSContext *ctx, JSValueConst this_val, const rl::RenderTexture *texture) noexcept
         -> JSValue {
         SPDLOG_TRACE("BeginTextureMode({})", *texture);
-        BeginTextureMode(*texture);
-        return JS_DupValue(ctx, this_val);
+        flush_sprites(ctx);
+        culling().target_size = Vector2 {.x = float(texture->texture.width), .y = float(texture->texture.height)};
+        return draw_call(ctx, this_val, [&] { BeginTextureMode(*texture); });
     }
 
     auto end_texture_mode(JSContext *ctx, JSValueConst this_val) noexcept -> JSValue {
         SPDLOG_TRACE("EndTextureMode()");
-        EndTextureMode();
-        return JS_DupValue(ctx, this_val);
+        flush_sprites(ctx);
+        culling().target_size = std::nullopt;
+        return draw_call(ctx, this_val, [&] { EndTextureMode(); });
     }
 
     auto
     with_texture(JSContext *ctx, JSValueConst this_val, const rl::RenderTexture *texture, JSValue function) noexcept
         -> JSValue {
+        const auto drawing = IsWindowReady();
         SPDLOG_TRACE("BeginTextureMode({})", *texture);
-        BeginTextureMode(*texture);
+        flush_sprites(ctx);
+        culling().target_size = Vector2 {.x = float(texture->texture.width), .y = float(texture->texture.height)};
+        if (drawing) BeginTextureMode(*texture);
         auto ret = JS_Call(ctx, function, JS_UNDEFINED, 0, nullptr);
         SPDLOG_TRACE("EndTextureMode()");
-        EndTextureMode();
+        flush_sprites(ctx);
+        culling().target_size = std::nullopt;
+        if (drawing) EndTextureMode();
         if (JS_IsException(ret)) {
             return ret;
         }
@@ -276,20 +585,31 @@ class JSGraphics: public JSClass<JSGraphics> {
     inline static auto instance_properties = PropertyList {
         export_method<&JSGraphics::clear>("clear"),
         export_method<&JSGraphics::circle>("circle"),
+        export_method<&JSGraphics::circles>("circles"),
         export_method<&JSGraphics::rectangle>("rectangle"),
         export_method<&JSGraphics::rectangle_v>("rectangleV"),
         export_method<&JSGraphics::rectangle_rec>("rectangleRec"),
         export_method<&JSGraphics::rectangle_pro>("rectanglePro"),
+        export_method<&JSGraphics::rectangles>("rectangles"),
         export_method<&JSGraphics::begin_camera_mode>("beginCameraMode"),
         export_method<&JSGraphics::end_camera_mode>("endCameraMode"),
         export_method<&JSGraphics::texture>("texture"),
+        export_method<&JSGraphics::textures>("textures"),
         export_method<&JSGraphics::texture_v>("textureV"),
         export_method<&JSGraphics::texture_ex>("textureEx"),
         export_method<&JSGraphics::texture_rec>("textureRec"),
         export_method<&JSGraphics::texture_pro>("texturePro"),
         export_method<&JSGraphics::texture_npatch>("textureNPatch"),
+        export_method<&JSGraphics::sprite>("sprite"),
+        export_method<&JSGraphics::flush_batch>("flush"),
+        export_getset<&JSGraphics::get_blend_mode, &JSGraphics::set_blend_mode>("blendMode"),
+        export_get_only<&JSGraphics::get_sprite_stats>("spriteStats"),
+        export_getset<&JSGraphics::get_culling, &JSGraphics::set_culling>("culling"),
+        export_get_only<&JSGraphics::get_cull_stats>("cullStats"),
         export_method<&JSGraphics::text>("text"),
         export_method<&JSGraphics::text_pro>("textPro"),
+        export_method<&JSGraphics::text_layout>("textLayout"),
+        export_get_only<&JSGraphics::get_text_cache_stats>("textCacheStats"),
         export_method<&JSGraphics::begin_texture_mode>("beginTextureMode"),
         export_method<&JSGraphics::end_texture_mode>("endTextureMode"),
         export_method<&JSGraphics::with_texture>("withTexture"),
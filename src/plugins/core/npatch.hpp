@@ -50,6 +50,8 @@ class JSNPatch: public JSClass<JSNPatch> {
   public: // JSClass implementation
     constexpr static auto class_name = "NPatch";
 
+    constexpr static bool pooled = true;
+
     inline static auto static_properties = PropertyList {};
 
     inline static auto instance_properties = PropertyList {
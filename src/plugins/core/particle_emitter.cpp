@@ -0,0 +1,257 @@
+#include <plugins/core/particle_emitter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include <rlgl.h>
+
+#include <plugins/core/culling.hpp>
+#include <plugins/core/sprite_batch.hpp>
+
+namespace glint::plugins::core {
+
+/// Quads submitted between render batch limit checks
+constexpr auto particle_chunk = size_t {1024};
+
+auto JSParticleEmitter::initialize(int capacity) noexcept -> void {
+    _capacity = size_t(capacity);
+    for (auto v : {&_x, &_y, &_vx, &_vy, &_age, &_life}) {
+        v->resize(_capacity);
+    }
+    particle_emitters().push_back(this);
+}
+
+auto JSParticleEmitter::apply(JSContext *ctx, const JSParticleEmitterOptions& o) noexcept -> JSResult<> {
+    if (o.texture) {
+        if (!JS_IsUndefined(o.texture->cget())) {
+            if (auto t = JSTexture::get_instance(*o.texture); !t) return t.error();
+        }
+        JS_FreeValue(ctx, _texture);
+        _texture = JS_DupValue(ctx, o.texture->cget());
+    }
+
+    if (o.position) _position = *o.position;
+    if (o.rate) set_rate(*o.rate);
+    if (o.lifetime) _lifetime = std::max(*o.lifetime, 0.0f);
+    if (o.lifetime_variance) _lifetime_variance = std::max(*o.lifetime_variance, 0.0f);
+    if (o.speed) _speed = *o.speed;
+    if (o.speed_variance) _speed_variance = std::max(*o.speed_variance, 0.0f);
+    if (o.direction) _direction = *o.direction;
+    if (o.spread) _spread = *o.spread;
+    if (o.gravity) _gravity = *o.gravity;
+    if (o.drag) _drag = std::clamp(*o.drag, 0.0f, 1.0f);
+    if (o.start_size) _start_size = *o.start_size;
+    if (o.end_size) _end_size = *o.end_size;
+    if (o.start_color) _start_color = *o.start_color;
+    if (o.end_color) _end_color = *o.end_color;
+    if (o.blend_mode) _blend_mode = *o.blend_mode;
+    if (o.auto_update) _auto_update = *o.auto_update;
+    // Particle size may have changed
+    _bounds_dirty = true;
+    return {};
+}
+
+auto JSParticleEmitter::configure(JSContext *ctx, JSValueConst this_val, JSParticleEmitterOptions options) noexcept
+    -> JSValue {
+    if (options.capacity && size_t(*options.capacity) != _capacity) {
+        return jsthrow(JSError::type_error(ctx, "ParticleEmitter capacity can only be set when constructing"));
+    }
+    if (auto r = apply(ctx, options); !r) return jsthrow(r.error());
+    return JS_DupValue(ctx, this_val);
+}
+
+auto JSParticleEmitter::burst(JSContext *ctx, JSValueConst this_val, int count) noexcept -> JSValue {
+    if (count > 0) emit(size_t(count));
+    return JS_DupValue(ctx, this_val);
+}
+
+auto JSParticleEmitter::update(JSContext *ctx, JSValueConst this_val, std::optional<float> dt) noexcept -> JSValue {
+    if (!dt) {
+        auto w = Engine::get(ctx).game_window();
+        dt = w != nullptr ? window::frame_time(*w) : GetFrameTime();
+    }
+    step(*dt);
+    return JS_DupValue(ctx, this_val);
+}
+
+auto JSParticleEmitter::clear(JSContext *ctx, JSValueConst this_val) noexcept -> JSValue {
+    _count = 0;
+    _pending = 0.0f;
+    _bounds_dirty = true;
+    return JS_DupValue(ctx, this_val);
+}
+
+auto JSParticleEmitter::emit(size_t count) noexcept -> void {
+    count = std::min(count, _capacity - _count);
+    auto unit = std::uniform_real_distribution<float> {-1.0f, 1.0f};
+    constexpr auto deg2rad = std::numbers::pi_v<float> / 180.0f;
+    for (auto i = _count; i < _count + count; i++) {
+        const auto angle = (_direction + unit(_rng) * _spread * 0.5f) * deg2rad;
+        const auto speed = _speed + unit(_rng) * _speed_variance;
+        _x[i] = _position.x;
+        _y[i] = _position.y;
+        _vx[i] = std::cos(angle) * speed;
+        _vy[i] = std::sin(angle) * speed;
+        _age[i] = 0.0f;
+        _life[i] = std::max(_lifetime + unit(_rng) * _lifetime_variance, 0.001f);
+    }
+    _count += count;
+    if (count > 0) _bounds_dirty = true;
+}
+
+auto JSParticleEmitter::step(float dt) noexcept -> void {
+    if (dt <= 0.0f) return;
+
+    if (_emitting && _rate > 0.0f) {
+        _pending += _rate * dt;
+        const auto whole = std::floor(_pending);
+        _pending -= whole;
+        emit(size_t(whole));
+    }
+
+    // Plain loops over separate arrays, so the compiler can vectorize each of them
+    const auto n = _count;
+    const auto damping = std::pow(1.0f - _drag, dt);
+    const auto gx = _gravity.x * dt;
+    const auto gy = _gravity.y * dt;
+    auto *x = _x.data();
+    auto *y = _y.data();
+    auto *vx = _vx.data();
+    auto *vy = _vy.data();
+    auto *age = _age.data();
+    for (size_t i = 0; i < n; i++) {
+        vx[i] = (vx[i] + gx) * damping;
+        vy[i] = (vy[i] + gy) * damping;
+    }
+    for (size_t i = 0; i < n; i++) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+    for (size_t i = 0; i < n; i++) {
+        age[i] += dt;
+    }
+
+    // Dead particles are replaced by the last live one, which keeps live ones packed
+    for (size_t i = 0; i < _count;) {
+        if (_age[i] < _life[i]) {
+            i++;
+            continue;
+        }
+        const auto last = --_count;
+        _x[i] = _x[last];
+        _y[i] = _y[last];
+        _vx[i] = _vx[last];
+        _vy[i] = _vy[last];
+        _age[i] = _age[last];
+        _life[i] = _life[last];
+    }
+    _bounds_dirty = true;
+}
+
+auto JSParticleEmitter::bounds() noexcept -> const Rectangle& {
+    if (!_bounds_dirty) return _bounds;
+    _bounds_dirty = false;
+    if (_count == 0) {
+        _bounds = {};
+        return _bounds;
+    }
+    const auto [min_x, max_x] = std::minmax_element(_x.begin(), _x.begin() + ptrdiff_t(_count));
+    const auto [min_y, max_y] = std::minmax_element(_y.begin(), _y.begin() + ptrdiff_t(_count));
+    const auto half = std::max(std::abs(_start_size), std::abs(_end_size)) * 0.5f;
+    _bounds = {
+        .x = *min_x - half,
+        .y = *min_y - half,
+        .width = *max_x - *min_x + half * 2.0f,
+        .height = *max_y - *min_y + half * 2.0f,
+    };
+    return _bounds;
+}
+
+auto JSParticleEmitter::draw(JSContext *ctx, JSValueConst this_val) noexcept -> JSValue {
+    SPDLOG_TRACE("Drawing {}", to_string());
+    if (_count == 0 || !visible(culling(), bounds())) return JS_DupValue(ctx, this_val);
+    if (!IsWindowReady()) return JS_DupValue(ctx, this_val);
+
+    auto texture_id = rlGetTextureIdDefault();
+    auto uv = Rectangle {.x = 0.0f, .y = 0.0f, .width = 1.0f, .height = 1.0f};
+    if (!JS_IsUndefined(_texture)) {
+        auto region = convert_from_js<TextureRegion>(borrow(ctx, _texture));
+        if (!region) return jsthrow(region.error());
+        const auto w = float(region->texture->width);
+        const auto h = float(region->texture->height);
+        texture_id = region->texture->id;
+        uv = {
+            .x = region->rect.x / w,
+            .y = region->rect.y / h,
+            .width = region->rect.width / w,
+            .height = region->rect.height / h,
+        };
+    }
+
+    // Sprites recorded so far were issued before the particles
+    flush(sprite_batch(), Engine::get(ctx).texture_store());
+
+    const auto lerp = [](float a, float b, float t) { return a + (b - a) * t; };
+    BeginBlendMode(_blend_mode);
+    rlSetTexture(texture_id);
+    for (size_t start = 0; start < _count; start += particle_chunk) {
+        const auto end = std::min(start + particle_chunk, _count);
+        rlCheckRenderBatchLimit(int(end - start) * 4);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (auto i = start; i < end; i++) {
+            const auto t = _age[i] / _life[i];
+            const auto half = lerp(_start_size, _end_size, t) * 0.5f;
+            rlColor4ub(
+                uint8_t(lerp(_start_color.r, _end_color.r, t)),
+                uint8_t(lerp(_start_color.g, _end_color.g, t)),
+                uint8_t(lerp(_start_color.b, _end_color.b, t)),
+                uint8_t(lerp(_start_color.a, _end_color.a, t))
+            );
+            const auto x0 = _x[i] - half;
+            const auto y0 = _y[i] - half;
+            const auto x1 = _x[i] + half;
+            const auto y1 = _y[i] + half;
+            rlTexCoord2f(uv.x, uv.y);
+            rlVertex2f(x0, y0);
+            rlTexCoord2f(uv.x, uv.y + uv.height);
+            rlVertex2f(x0, y1);
+            rlTexCoord2f(uv.x + uv.width, uv.y + uv.height);
+            rlVertex2f(x1, y1);
+            rlTexCoord2f(uv.x + uv.width, uv.y);
+            rlVertex2f(x1, y0);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+    EndBlendMode();
+
+    return JS_DupValue(ctx, this_val);
+}
+
+auto JSParticleEmitter::custom_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+    -> JSValue {
+    auto args = unpack_args<std::optional<JSParticleEmitterOptions>>(ctx, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto options = std::get<0>(*args).value_or(JSParticleEmitterOptions {});
+    const auto capacity = options.capacity.value_or(1000);
+    if (capacity <= 0) {
+        return jsthrow(JSError::range_error(ctx, fmt::format("Invalid ParticleEmitter capacity {}", capacity)));
+    }
+
+    auto obj = create_instance_this(borrow(ctx, this_val), capacity);
+    if (JS_IsUndefined(obj)) return JS_EXCEPTION;
+    auto emitter = get_instance(borrow(ctx, obj));
+    if (!emitter) {
+        JS_FreeValue(ctx, obj);
+        return jsthrow(emitter.error());
+    }
+    if (auto r = (*emitter)->apply(ctx, options); !r) {
+        JS_FreeValue(ctx, obj);
+        return jsthrow(r.error());
+    }
+    return obj;
+}
+
+} // namespace glint::plugins::core
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <engine.hpp>
+#include <plugins/core/color.hpp>
+#include <plugins/core/texture.hpp>
+#include <plugins/core/vector2.hpp>
+#include <quickjs.hpp>
+#include <raylib.hpp>
+
+namespace glint::plugins::core {
+
+using namespace js;
+
+/// Emitter settings, every field is optional and unset ones keep their current value
+struct JSParticleEmitterOptions {
+    std::optional<int> capacity {};
+    std::optional<Vector2> position {};
+    std::optional<float> rate {};
+    std::optional<float> lifetime {};
+    std::optional<float> lifetime_variance {};
+    std::optional<float> speed {};
+    std::optional<float> speed_variance {};
+    std::optional<float> direction {};
+    std::optional<float> spread {};
+    std::optional<Vector2> gravity {};
+    std::optional<float> drag {};
+    std::optional<float> start_size {};
+    std::optional<float> end_size {};
+    std::optional<Color> start_color {};
+    std::optional<Color> end_color {};
+    std::optional<Value> texture {};
+    std::optional<int> blend_mode {};
+    std::optional<bool> auto_update {};
+};
+
+class JSParticleEmitter;
+
+/// Live emitters of the main thread, stepped by the core plugin every update
+inline auto particle_emitters() noexcept -> std::vector<JSParticleEmitter *>& {
+    static auto emitters = std::vector<JSParticleEmitter *> {};
+    return emitters;
+}
+
+/// Particles simulated and drawn natively. State lives in one array per attribute, so integration runs as
+/// tight loops over contiguous floats, and the whole emitter is drawn as one run of quads sharing a texture
+class JSParticleEmitter: public JSClass<JSParticleEmitter> {
+  public:
+    [[nodiscard]] auto get_position() const noexcept -> Vector2 { return _position; }
+
+    auto set_position(Vector2 position) noexcept -> void { _position = position; }
+
+    [[nodiscard]] auto get_rate() const noexcept -> float { return _rate; }
+
+    auto set_rate(float rate) noexcept -> void { _rate = std::max(rate, 0.0f); }
+
+    [[nodiscard]] auto get_gravity() const noexcept -> Vector2 { return _gravity; }
+
+    auto set_gravity(Vector2 gravity) noexcept -> void { _gravity = gravity; }
+
+    [[nodiscard]] auto get_emitting() const noexcept -> bool { return _emitting; }
+
+    auto set_emitting(bool emitting) noexcept -> void { _emitting = emitting; }
+
+    [[nodiscard]] auto get_blend_mode() const noexcept -> int { return _blend_mode; }
+
+    auto set_blend_mode(int mode) noexcept -> void { _blend_mode = mode; }
+
+    [[nodiscard]] auto get_auto_update() const noexcept -> bool { return _auto_update; }
+
+    auto set_auto_update(bool auto_update) noexcept -> void { _auto_update = auto_update; }
+
+    [[nodiscard]] auto get_count() const noexcept -> int { return int(_count); }
+
+    [[nodiscard]] auto get_capacity() const noexcept -> int { return int(_capacity); }
+
+    /// Applies options, keeping current values of unset fields
+    auto configure(JSContext *ctx, JSValueConst this_val, JSParticleEmitterOptions options) noexcept -> JSValue;
+
+    /// Emits `count` particles at once, as many as fit
+    auto burst(JSContext *ctx, JSValueConst this_val, int count) noexcept -> JSValue;
+
+    /// Advances particles by `dt` seconds, or frame time without arguments
+    auto update(JSContext *ctx, JSValueConst this_val, std::optional<float> dt) noexcept -> JSValue;
+
+    /// Draws all live particles as one run of quads
+    auto draw(JSContext *ctx, JSValueConst this_val) noexcept -> JSValue;
+
+    auto clear(JSContext *ctx, JSValueConst this_val) noexcept -> JSValue;
+
+    /// Emits by rate and integrates particles for `dt` seconds
+    auto step(float dt) noexcept -> void;
+
+    [[nodiscard]] auto to_string() const noexcept -> std::string {
+        return fmt::format("ParticleEmitter({}/{})", _count, _capacity);
+    }
+
+  private:
+    // Particle state, one array per attribute, live particles packed at the front
+    std::vector<float> _x {};
+    std::vector<float> _y {};
+    std::vector<float> _vx {};
+    std::vector<float> _vy {};
+    std::vector<float> _age {};
+    std::vector<float> _life {};
+    size_t _count = 0;
+    size_t _capacity = 0;
+
+    Vector2 _position {};
+    /// Particles per second
+    float _rate = 0.0f;
+    /// Fraction of a particle carried over to the next step
+    float _pending = 0.0f;
+    bool _emitting = true;
+    bool _auto_update = true;
+    float _lifetime = 1.0f;
+    float _lifetime_variance = 0.0f;
+    float _speed = 50.0f;
+    float _speed_variance = 0.0f;
+    /// Degrees, 0 points right
+    float _direction = -90.0f;
+    float _spread = 360.0f;
+    Vector2 _gravity {};
+    /// Fraction of velocity lost per second
+    float _drag = 0.0f;
+    float _start_size = 4.0f;
+    float _end_size = 4.0f;
+    Color _start_color = WHITE;
+    Color _end_color = WHITE;
+    int _blend_mode = BLEND_ALPHA;
+    /// Owned Texture or undefined to draw untextured squares
+    JSValue _texture = JS_UNDEFINED;
+    /// Area covered by particles, for culling. Recomputed on draw after particles were emitted, moved or resized
+    Rectangle _bounds {};
+    bool _bounds_dirty = false;
+    std::minstd_rand _rng {std::random_device {}()};
+
+    auto emit(size_t count) noexcept -> void;
+
+    /// Area covered by live particles, recomputed when dirty
+    auto bounds() noexcept -> const Rectangle&;
+
+    auto apply(JSContext *ctx, const JSParticleEmitterOptions& options) noexcept -> JSResult<>;
+
+    static auto custom_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+        -> JSValue;
+
+  public: // JSClass implementation
+    constexpr static auto class_name = "ParticleEmitter";
+
+    inline static auto static_properties = PropertyList {};
+
+    inline static auto instance_properties = PropertyList {
+        export_getset<&JSParticleEmitter::get_position, &JSParticleEmitter::set_position>("position"),
+        export_getset<&JSParticleEmitter::get_rate, &JSParticleEmitter::set_rate>("rate"),
+        export_getset<&JSParticleEmitter::get_gravity, &JSParticleEmitter::set_gravity>("gravity"),
+        export_getset<&JSParticleEmitter::get_emitting, &JSParticleEmitter::set_emitting>("emitting"),
+        export_getset<&JSParticleEmitter::get_blend_mode, &JSParticleEmitter::set_blend_mode>("blendMode"),
+        export_getset<&JSParticleEmitter::get_auto_update, &JSParticleEmitter::set_auto_update>("autoUpdate"),
+        export_get_only<&JSParticleEmitter::get_count>("count"),
+        export_get_only<&JSParticleEmitter::get_capacity>("capacity"),
+        export_method<&JSParticleEmitter::configure>("configure"),
+        export_method<&JSParticleEmitter::burst>("burst"),
+        export_method<&JSParticleEmitter::update>("update"),
+        export_method<&JSParticleEmitter::draw>("draw"),
+        export_method<&JSParticleEmitter::clear>("clear"),
+        export_method<&JSParticleEmitter::to_string>("toString"),
+    };
+
+    auto initialize(int capacity) noexcept -> void;
+
+    constexpr static JSCFunction *constructor = &custom_constructor;
+
+    constexpr static JSClassFinalizer *class_finalizer = [](JSRuntime *rt, JSValueConst val) noexcept -> void {
+        auto ptr = static_cast<JSParticleEmitter *>(JS_GetOpaque(val, JSParticleEmitter::class_id(rt)));
+        if (ptr == nullptr) return;
+        std::erase(particle_emitters(), ptr);
+        JS_FreeValueRT(rt, ptr->_texture);
+        deallocate(ptr);
+    };
+
+    constexpr static JSClassGCMark *class_gc_mark = [](JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark) {
+        auto ptr = static_cast<JSParticleEmitter *>(JS_GetOpaque(val, JSParticleEmitter::class_id(rt)));
+        if (ptr == nullptr) return;
+        JS_MarkValue(rt, ptr->_texture, mark);
+    };
+};
+
+inline auto particle_emitter_module(JSContext *ctx) -> JSModuleDef * {
+    auto m = JS_NewCModule(ctx, "@glint/core/ParticleEmitter", [](auto ctx, auto m) -> int {
+        auto ctor = JSParticleEmitter::define(ctx).take();
+        JS_SetModuleExport(ctx, m, "ParticleEmitter", JS_DupValue(ctx, ctor));
+        JS_SetModuleExport(ctx, m, "default", ctor);
+        return 0;
+    });
+
+    JS_AddModuleExport(ctx, m, "ParticleEmitter");
+    JS_AddModuleExport(ctx, m, "default");
+    return m;
+}
+
+} // namespace glint::plugins::core
+
+namespace glint::js {
+
+using plugins::core::JSParticleEmitterOptions;
+
+template<>
+inline auto convert_from_js<JSParticleEmitterOptions>(const Value& val) noexcept
+    -> JSResult<JSParticleEmitterOptions> try {
+    auto o = JSParticleEmitterOptions {};
+    auto obj = Object::from_value(val);
+    if (!obj) return obj.error();
+
+    if (auto v = obj->at<std::optional<int>>("capacity")) o.capacity = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<Vector2>>("position")) o.position = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<float>>("rate")) o.rate = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<float>>("lifetime")) o.lifetime = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<float>>("lifetimeVariance")) o.lifetime_variance = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<float>>("speed")) o.speed = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<float>>("speedVariance")) o.speed_variance = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<float>>("direction")) o.direction = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<float>>("spread")) o.spread = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<Vector2>>("gravity")) o.gravity = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<float>>("drag")) o.drag = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<float>>("startSize")) o.start_size = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<float>>("endSize")) o.end_size = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<Color>>("startColor")) o.start_color = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<Color>>("endColor")) o.end_color = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<Value>>("texture")) o.texture = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<int>>("blendMode")) o.blend_mode = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<bool>>("autoUpdate")) o.auto_update = *v;
+    else return v.error();
+
+    return o;
+} catch (std::exception& e) {
+    return JSError::plain_error(val.ctx(), fmt::format("Unexpected C++ exception: {}", e.what()));
+}
+
+} // namespace glint::js
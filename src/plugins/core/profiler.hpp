@@ -0,0 +1,85 @@
+#pragma once
+
+#include <quickjs.h>
+#include <engine.hpp>
+#include <engine/profiler.hpp>
+#include <quickjs.hpp>
+
+namespace glint::plugins::core {
+
+using namespace js;
+
+class JSProfiler: public JSClass<JSProfiler> {
+  public:
+    [[nodiscard]] auto get_enabled() const noexcept -> bool { return _profiler->enabled; }
+
+    auto set_enabled(bool enabled) noexcept -> void { _profiler->enabled = enabled; }
+
+    [[nodiscard]] auto get_overlay() const noexcept -> bool { return _profiler->overlay; }
+
+    auto set_overlay(bool overlay) noexcept -> void { _profiler->overlay = overlay; }
+
+    /// Returns `{ [phase]: { last, p50, p95, p99, max } }` in milliseconds over the recorded history
+    auto stats(JSContext *ctx) const noexcept -> JSValue {
+        auto obj = JS_NewObject(ctx);
+        for (const auto& track : _profiler->tracks) {
+            const auto s = engine::profiler::stats(*_profiler, track);
+            auto entry = JS_NewObject(ctx);
+            JS_SetPropertyStr(ctx, entry, "last", JS_NewFloat64(ctx, s.last));
+            JS_SetPropertyStr(ctx, entry, "p50", JS_NewFloat64(ctx, s.p50));
+            JS_SetPropertyStr(ctx, entry, "p95", JS_NewFloat64(ctx, s.p95));
+            JS_SetPropertyStr(ctx, entry, "p99", JS_NewFloat64(ctx, s.p99));
+            JS_SetPropertyStr(ctx, entry, "max", JS_NewFloat64(ctx, s.max));
+            JS_SetPropertyStr(ctx, obj, track.name.c_str(), entry);
+        }
+        return obj;
+    }
+
+    /// Returns `{ [class]: { live, peak, pooled } }` for every native class instantiated so far
+    auto instances(JSContext *ctx) const noexcept -> JSValue {
+        auto obj = JS_NewObject(ctx);
+        for (const auto counts : instance_stats()) {
+            auto entry = JS_NewObject(ctx);
+            JS_SetPropertyStr(ctx, entry, "live", JS_NewInt64(ctx, int64_t(counts->live)));
+            JS_SetPropertyStr(ctx, entry, "peak", JS_NewInt64(ctx, int64_t(counts->peak)));
+            JS_SetPropertyStr(ctx, entry, "pooled", JS_NewBool(ctx, counts->pooled));
+            JS_SetPropertyStr(ctx, obj, counts->class_name, entry);
+        }
+        return obj;
+    }
+
+  public: // JSClass implementation
+    constexpr static auto class_name = "Profiler";
+
+    inline static auto static_properties = PropertyList {};
+
+    inline static auto instance_properties = PropertyList {
+        export_getset<&JSProfiler::get_enabled, &JSProfiler::set_enabled>("enabled"),
+        export_getset<&JSProfiler::get_overlay, &JSProfiler::set_overlay>("overlay"),
+        export_method<&JSProfiler::stats>("stats"),
+        export_method<&JSProfiler::instances>("instances"),
+    };
+
+    auto initialize(engine::profiler::Profiler *profiler) noexcept { _profiler = profiler; }
+
+  private:
+    engine::profiler::Profiler *_profiler = nullptr;
+};
+
+inline auto profiler_module(::JSContext *ctx) -> ::JSModuleDef * {
+    auto m = ::JS_NewCModule(ctx, "@glint/core/profiler", [](auto ctx, auto m) -> int {
+        JSProfiler::define(ctx);
+        auto instance = JSProfiler::create_instance(ctx, &Engine::get(ctx).profiler());
+        JS_SetModuleExport(ctx, m, "profiler", JS_DupValue(ctx, instance));
+        JS_SetModuleExport(ctx, m, "default", instance);
+
+        return 0;
+    });
+
+    JS_AddModuleExport(ctx, m, "profiler");
+    JS_AddModuleExport(ctx, m, "default");
+
+    return m;
+}
+
+} // namespace glint::plugins::core
@@ -36,6 +36,8 @@ class JSRectangle: public JSClass<JSRectangle> {
   public: // JSClass implementation
     constexpr static auto class_name = "Rectangle";
 
+    constexpr static bool pooled = true;
+
     inline static auto static_properties = PropertyList {
         export_static_method<&JSRectangle::zero>("zero"),
     };
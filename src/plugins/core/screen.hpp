@@ -4,6 +4,8 @@
 
 #include <quickjs.h>
 #include <raylib.h>
+#include <engine.hpp>
+#include <engine/window.hpp>
 #include <quickjs.hpp>
 
 namespace glint::plugins::core {
@@ -12,13 +14,35 @@ using namespace js;
 
 class JSScreen: public JSClass<JSScreen> {
   public:
-    [[nodiscard]] auto get_dt() const noexcept -> float { return GetFrameTime(); }
-
-    [[nodiscard]] auto get_time() const noexcept -> double { return GetTime(); }
-
-    [[nodiscard]] auto get_width() const noexcept -> int { return GetScreenWidth(); }
-
-    [[nodiscard]] auto get_height() const noexcept -> int { return GetScreenHeight(); }
+    [[nodiscard]] auto get_dt(JSContext *ctx) const noexcept -> float {
+        const auto& e = Engine::get(ctx);
+        if (e.timestep().in_fixed_update) return float(e.timestep().step);
+        auto w = e.game_window();
+        return w != nullptr ? window::frame_time(*w) : GetFrameTime();
+    }
+
+    [[nodiscard]] auto get_fixed_dt(JSContext *ctx) const noexcept -> float {
+        return float(Engine::get(ctx).timestep().step);
+    }
+
+    [[nodiscard]] auto get_alpha(JSContext *ctx) const noexcept -> float {
+        return engine::timestep::alpha(Engine::get(ctx).timestep());
+    }
+
+    [[nodiscard]] auto get_time(JSContext *ctx) const noexcept -> double {
+        auto w = Engine::get(ctx).game_window();
+        return w != nullptr ? window::time(*w) : GetTime();
+    }
+
+    [[nodiscard]] auto get_width(JSContext *ctx) const noexcept -> int {
+        auto w = Engine::get(ctx).game_window();
+        return w != nullptr ? window::width(*w) : GetScreenWidth();
+    }
+
+    [[nodiscard]] auto get_height(JSContext *ctx) const noexcept -> int {
+        auto w = Engine::get(ctx).game_window();
+        return w != nullptr ? window::height(*w) : GetScreenHeight();
+    }
 
   public: // JSClass implementation
     constexpr static auto class_name = "Screen";
@@ -27,6 +51,8 @@ class JSScreen: public JSClass<JSScreen> {
 
     inline static auto instance_properties = PropertyList {
         export_get_only<&JSScreen::get_dt>("dt"),
+        export_get_only<&JSScreen::get_fixed_dt>("fixedDt"),
+        export_get_only<&JSScreen::get_alpha>("alpha"),
         export_get_only<&JSScreen::get_time>("time"),
         export_get_only<&JSScreen::get_width>("width"),
         export_get_only<&JSScreen::get_height>("height"),
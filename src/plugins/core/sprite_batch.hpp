@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include <raylib.h>
+
+#include <data.hpp>
+#include <resource_store.hpp>
+
+namespace glint::plugins::core {
+
+/// Textured quad recorded by `graphics.sprite` and drawn on the next flush
+struct Sprite {
+    /// Sprites of lower layers are drawn first
+    int layer = 0;
+    int blend = BLEND_ALPHA;
+    /// Keeps texture alive until the sprite is drawn
+    ResourceStore<TextureData>::Handle handle {};
+    ::Texture texture {};
+    Rectangle source {};
+    Rectangle dest {};
+    Vector2 origin {};
+    float rotation = 0.0f;
+    Color tint = WHITE;
+};
+
+struct SpriteBatchStats {
+    size_t sprites = 0;
+    /// Runs of sprites sharing texture and blend mode. rlgl draws each run with one draw call,
+    /// unless it overflows its vertex buffer
+    size_t draw_calls = 0;
+    size_t texture_switches = 0;
+};
+
+/// Sprites recorded since the last flush. They are drawn sorted by layer, blend mode and texture,
+/// so consecutive quads share GPU state and rlgl merges them into as few draw calls as possible
+struct SpriteBatch {
+    std::vector<Sprite> sprites {};
+    /// Blend mode of newly recorded sprites
+    int blend = BLEND_ALPHA;
+    /// Counters of the frame in progress
+    SpriteBatchStats frame {};
+    /// Counters of the last finished frame
+    SpriteBatchStats last_frame {};
+};
+
+/// Batch of the main thread, the only one that draws
+inline auto sprite_batch() noexcept -> SpriteBatch& {
+    static auto batch = SpriteBatch {};
+    return batch;
+}
+
+/// Draws recorded sprites and releases their textures. Must be called from main thread while drawing
+inline auto flush(SpriteBatch& self, ResourceStore<TextureData>& textures) noexcept -> void {
+    if (self.sprites.empty()) return;
+
+    // Stable, so sprites sharing layer and texture keep the order they were recorded in
+    std::ranges::stable_sort(self.sprites, {}, [](const Sprite& s) {
+        return std::tuple(s.layer, s.blend, s.texture.id);
+    });
+
+    const auto drawing = IsWindowReady();
+    const Sprite *prev = nullptr;
+    for (const auto& s : self.sprites) {
+        if (prev == nullptr || prev->texture.id != s.texture.id || prev->blend != s.blend) {
+            self.frame.draw_calls++;
+            if (prev != nullptr && prev->texture.id != s.texture.id) self.frame.texture_switches++;
+            if (drawing && (prev == nullptr || prev->blend != s.blend)) BeginBlendMode(s.blend);
+        }
+        if (drawing) DrawTexturePro(s.texture, s.source, s.dest, s.origin, s.rotation, s.tint);
+        prev = &s;
+    }
+    if (drawing) EndBlendMode();
+
+    self.frame.sprites += self.sprites.size();
+    for (const auto& s : self.sprites) textures.release(s.handle);
+    self.sprites.clear();
+}
+
+/// Flushes remaining sprites and starts counting the next frame
+inline auto end_frame(SpriteBatch& self, ResourceStore<TextureData>& textures) noexcept -> void {
+    flush(self, textures);
+    self.last_frame = self.frame;
+    self.frame = {};
+}
+
+} // namespace glint::plugins::core
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include <engine.hpp>
+#include <plugins/core/font.hpp>
+#include <plugins/core/glyph_run.hpp>
+#include <quickjs.hpp>
+#include <raylib.hpp>
+
+namespace glint::plugins::core {
+
+using namespace js;
+
+/// String laid out against a font once and redrawn from its glyph run until text, size, spacing or the font
+/// atlas change
+class JSTextLayout: public JSClass<JSTextLayout> {
+  public:
+    [[nodiscard]] auto get_text() const noexcept -> std::string { return _text; }
+
+    auto set_text(std::string text) noexcept -> void {
+        if (text == _text) return;
+        _text = std::move(text);
+        _dirty = true;
+    }
+
+    [[nodiscard]] auto get_font_size() const noexcept -> float { return _font_size; }
+
+    auto set_font_size(float font_size) noexcept -> void {
+        _dirty = _dirty || font_size != _font_size;
+        _font_size = font_size;
+    }
+
+    [[nodiscard]] auto get_spacing() const noexcept -> float { return _spacing; }
+
+    auto set_spacing(float spacing) noexcept -> void {
+        _dirty = _dirty || spacing != _spacing;
+        _spacing = spacing;
+    }
+
+    [[nodiscard]] auto get_font(JSContext *ctx) const noexcept -> JSValue { return JS_DupValue(ctx, _font); }
+
+    [[nodiscard]] auto get_width(JSContext *ctx) noexcept -> float { return run(ctx).size.x; }
+
+    [[nodiscard]] auto get_height(JSContext *ctx) noexcept -> float { return run(ctx).size.y; }
+
+    [[nodiscard]] auto get_glyphs(JSContext *ctx) noexcept -> int { return int(run(ctx).quads.size()); }
+
+    /// Font the text is laid out against, the default one when none was given
+    [[nodiscard]] auto font(JSContext *ctx) const noexcept -> ::Font {
+        if (JS_IsUndefined(_font)) return GetFontDefault();
+        if (auto f = convert_from_js<const rl::Font *>(borrow(ctx, _font))) return **f;
+        return GetFontDefault();
+    }
+
+    /// Glyph run of the current text, laid out again only when something it depends on changed
+    auto run(JSContext *ctx) noexcept -> const GlyphRun& {
+        const auto f = font(ctx);
+        if (_dirty || font_key(f) != _shaped_for) {
+            _run = shape(f, _text, _font_size, _spacing);
+            _shaped_for = font_key(f);
+            _dirty = false;
+        }
+        return _run;
+    }
+
+    [[nodiscard]] auto to_string() const noexcept -> std::string {
+        return fmt::format("TextLayout('{}', {})", _text, _font_size);
+    }
+
+  private:
+    /// Owned Font or undefined for the default font
+    JSValue _font = JS_UNDEFINED;
+    std::string _text {};
+    float _font_size = 0.0f;
+    float _spacing = 0.0f;
+    GlyphRun _run {};
+    FontKey _shaped_for {};
+    bool _dirty = true;
+
+    static auto custom_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+        -> JSValue {
+        auto args = unpack_args<std::string, float, std::optional<JSFont *>, std::optional<float>>(ctx, argc, argv);
+        if (!args) return jsthrow(args.error());
+        auto [text, font_size, font, spacing] = std::move(*args);
+
+        auto font_value = font ? JS_DupValue(ctx, argv[2]) : JS_UNDEFINED;
+        auto obj = create_instance_this(
+            borrow(ctx, this_val),
+            font_value,
+            std::move(text),
+            font_size,
+            spacing.value_or(0.0f)
+        );
+        if (JS_IsUndefined(obj)) {
+            JS_FreeValue(ctx, font_value);
+            return JS_EXCEPTION;
+        }
+        return obj;
+    }
+
+  public: // JSClass implementation
+    constexpr static auto class_name = "TextLayout";
+
+    inline static auto static_properties = PropertyList {};
+
+    inline static auto instance_properties = PropertyList {
+        export_getset<&JSTextLayout::get_text, &JSTextLayout::set_text>("text"),
+        export_getset<&JSTextLayout::get_font_size, &JSTextLayout::set_font_size>("fontSize"),
+        export_getset<&JSTextLayout::get_spacing, &JSTextLayout::set_spacing>("spacing"),
+        export_get_only<&JSTextLayout::get_font>("font"),
+        export_get_only<&JSTextLayout::get_width>("width"),
+        export_get_only<&JSTextLayout::get_height>("height"),
+        export_get_only<&JSTextLayout::get_glyphs>("glyphs"),
+        export_method<&JSTextLayout::to_string>("toString"),
+    };
+
+    /// Takes ownership of `font`
+    auto initialize(JSValue font, std::string text, float font_size, float spacing) noexcept -> void {
+        _font = font;
+        _text = std::move(text);
+        _font_size = font_size;
+        _spacing = spacing;
+    }
+
+    constexpr static JSCFunction *constructor = &custom_constructor;
+
+    constexpr static JSClassFinalizer *class_finalizer = [](JSRuntime *rt, JSValueConst val) noexcept -> void {
+        auto ptr = static_cast<JSTextLayout *>(JS_GetOpaque(val, JSTextLayout::class_id(rt)));
+        if (ptr == nullptr) return;
+        JS_FreeValueRT(rt, ptr->_font);
+        deallocate(ptr);
+    };
+
+    constexpr static JSClassGCMark *class_gc_mark = [](JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark) {
+        auto ptr = static_cast<JSTextLayout *>(JS_GetOpaque(val, JSTextLayout::class_id(rt)));
+        if (ptr == nullptr) return;
+        JS_MarkValue(rt, ptr->_font, mark);
+    };
+};
+
+inline auto text_layout_module(JSContext *ctx) -> JSModuleDef * {
+    auto m = JS_NewCModule(ctx, "@glint/core/TextLayout", [](auto ctx, auto m) -> int {
+        auto ctor = JSTextLayout::define(ctx).take();
+        JS_SetModuleExport(ctx, m, "TextLayout", JS_DupValue(ctx, ctor));
+        JS_SetModuleExport(ctx, m, "default", ctor);
+        return 0;
+    });
+
+    JS_AddModuleExport(ctx, m, "TextLayout");
+    JS_AddModuleExport(ctx, m, "default");
+    return m;
+}
+
+} // namespace glint::plugins::core
+
+namespace glint::js {
+
+template<>
+inline auto convert_from_js<plugins::core::JSTextLayout *>(const Value& val) noexcept
+    -> JSResult<plugins::core::JSTextLayout *> {
+    return plugins::core::JSTextLayout::get_instance(val);
+}
+
+} // namespace glint::js
@@ -9,16 +9,20 @@ auto JSTexture::custom_constructor(JSContext *ctx, JSValueConst this_val, int ar
     if (!opts) return jsthrow(opts.error());
     auto& e = Engine::get(ctx);
 
-    const auto handle = std::visit(
-        [&](auto&& arg) -> JSResult<ResourceStore<TextureData>::Handle> {
+    using Loaded = std::pair<ResourceStore<TextureData>::Handle, std::optional<Rectangle>>;
+    const auto loaded = std::visit(
+        [&](auto&& arg) -> JSResult<Loaded> {
             using T = std::decay_t<decltype(arg)>;
 
             if constexpr (std::is_same_v<T, JSTextureLoadByName>) {
-                return e.texture_store().load_by_name(arg.name);
+                if (auto region = load_from_atlas(ctx, arg.name)) return Loaded(*region);
+                return Loaded(e.texture_store().load_by_name(arg.name), std::nullopt);
             } else if constexpr (std::is_same_v<T, JSTextureLoadByParams>) {
-                return e.texture_store().load(arg.name, [&]() -> TextureData {
+                if (auto region = load_from_atlas(ctx, arg.path.generic_string())) return Loaded(*region);
+                const auto handle = e.texture_store().load(arg.name, [&]() -> TextureData {
                     return TextureData::load(arg.path, e.file_store());
                 });
+                return Loaded(handle, std::nullopt);
             } else if constexpr (std::is_same_v<T, std::monostate>) {
                 return JSError::type_error(ctx, "Either name or path must be present in options");
             } else {
@@ -27,7 +31,7 @@ auto JSTexture::custom_constructor(JSContext *ctx, JSValueConst this_val, int ar
         },
         std::move(*opts)
     );
-    if (!handle) return jsthrow(handle.error());
+    if (!loaded) return jsthrow(loaded.error());
 
     auto proto = JS_GetPropertyStr(ctx, this_val, "prototype");
     if (JS_IsException(proto)) {
@@ -41,9 +45,8 @@ auto JSTexture::custom_constructor(JSContext *ctx, JSValueConst this_val, int ar
         return JS_GetException(ctx);
     }
 
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-    auto ptr = static_cast<JSTexture *>(new (std::nothrow) JSTexture());
-    ptr->initialize(*handle);
+    auto ptr = JSTexture::allocate();
+    ptr->initialize(loaded->first, loaded->second);
     JS_SetOpaque(obj, ptr);
 
     return obj;
@@ -51,6 +54,113 @@ auto JSTexture::custom_constructor(JSContext *ctx, JSValueConst this_val, int ar
     return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
 }
 
+auto JSTexture::load_async(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+    -> JSValue try {
+    (void)this_val;
+    SPDLOG_TRACE("Texture.load/{}", argc);
+    auto opts = read_texture_options_from_args(ctx, argc, argv);
+    if (!opts) return jsthrow(opts.error());
+    auto promise = Promise::create(ctx);
+    if (!promise) return jsthrow(promise.error());
+    auto& e = Engine::get(ctx);
+
+    if (const auto by_name = std::get_if<JSTextureLoadByName>(&*opts)) {
+        if (auto region = load_from_atlas(ctx, by_name->name)) {
+            promise->resolve(create_instance(ctx, region->first, region->second));
+        } else {
+            const auto handle = e.texture_store().load_by_name(by_name->name);
+            promise->resolve(create_instance(ctx, handle, std::optional<Rectangle> {}));
+        }
+        return promise->value();
+    }
+
+    const auto params = std::get_if<JSTextureLoadByParams>(&*opts);
+    if (params == nullptr) return jsthrow(JSError::type_error(ctx, "Either name or path must be present in options"));
+
+    if (auto region = load_from_atlas(ctx, params->path.generic_string())) {
+        promise->resolve(create_instance(ctx, region->first, region->second));
+        return promise->value();
+    }
+
+    if (const auto handle = e.texture_store().load_by_name(params->name); handle != 0) {
+        promise->resolve(create_instance(ctx, handle, std::optional<Rectangle> {}));
+        return promise->value();
+    }
+
+    struct Job {
+        JSTextureLoadByParams params;
+        rl::Image image {};
+        std::string error {};
+    };
+    auto job = std::make_shared<Job>(std::move(*params));
+
+    engine::loader::submit(
+        e.loader(),
+        {
+            .work =
+                [job, &e] {
+                    auto file = e.file_store().map(job->params.path);
+                    if (!file) {
+                        job->error = file.error()->msg();
+                        return;
+                    }
+                    const auto extension = job->params.path.extension().string();
+                    job->image = rl::Image::load_from_memory(extension.c_str(), file->data());
+                    if (!IsImageValid(job->image)) job->error = "Unsupported or corrupted image";
+                },
+            .finish =
+                [job, ctx, &e, promise = std::move(*promise)]() mutable {
+                    if (!job->error.empty()) {
+                        const auto msg =
+                            fmt::format("Could not load texture {}: {}", job->params.path.string(), job->error);
+                        promise.reject(JS_NewPlainError(ctx, "%s", msg.c_str()));
+                        return;
+                    }
+                    const auto handle = e.texture_store().load(job->params.name, [&] {
+                        return TextureData::from_image(job->params.path, job->image);
+                    });
+                    job->image = {};
+                    promise.resolve(create_instance(ctx, handle, std::optional<Rectangle> {}));
+                },
+        }
+    );
+
+    return promise->value();
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+auto JSTexture::load_from_atlas(JSContext *ctx, const std::string& name) noexcept
+    -> std::optional<std::pair<ResourceStore<TextureData>::Handle, Rectangle>> {
+    auto& e = Engine::get(ctx);
+    const auto region = engine::atlas::find(e.atlas(), name);
+    if (region == nullptr) return std::nullopt;
+    // Page reference owned by the new texture, released by finalizer
+    e.texture_store().get(region->page);
+    return std::pair(region->page, region->rect);
+}
+
+auto JSTexture::build_atlas(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+    -> JSValue try {
+    (void)this_val;
+    SPDLOG_TRACE("Texture.atlas/{}", argc);
+    auto args = unpack_args<std::vector<std::string>, std::optional<JSTextureAtlasOptions>>(ctx, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto& [paths, opts] = *args;
+
+    auto options = engine::atlas::Options {};
+    if (opts && opts->page_size) options.page_size = *opts->page_size;
+    if (opts && opts->padding) options.padding = *opts->padding;
+    if (options.page_size <= 0) return jsthrow(JSError::range_error(ctx, "Atlas page size must be positive"));
+
+    auto& e = Engine::get(ctx);
+    auto pages = engine::atlas::build(e.atlas(), e.texture_store(), e.file_store(), paths, options);
+    if (!pages) return JS_ThrowPlainError(ctx, "%s", pages.error()->msg().c_str());
+    return JS_NewInt64(ctx, int64_t(*pages));
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
 auto JSTexture::custom_finalizer(JSRuntime *rt, JSValueConst val) noexcept -> void {
     SPDLOG_TRACE("Finalizing Texture");
     auto ptr = static_cast<JSTexture *>(JS_GetOpaque(val, JSTexture::class_id(rt)));
@@ -61,8 +171,7 @@ auto JSTexture::custom_finalizer(JSRuntime *rt, JSValueConst val) noexcept -> vo
 
     auto& e = Engine::get(rt);
     e.texture_store().release(ptr->_handle);
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-    delete ptr;
+    JSTexture::deallocate(ptr);
 };
 
 auto JSTexture::read_texture_options_from_args(JSContext *ctx, int argc, JSValueConst *argv) noexcept
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <variant>
 
@@ -28,6 +30,29 @@ struct JSTextureLoadByParams {
 
 using JSTextureLoadMode = std::variant<std::monostate, JSTextureLoadByName, JSTextureLoadByParams>;
 
+struct JSTextureAtlasOptions {
+    std::optional<int> page_size {};
+    std::optional<int> padding {};
+};
+
+/// Part of a GPU texture drawn for a `Texture`: whole texture, or the image's place in an atlas page
+struct TextureRegion {
+    const rl::Texture *texture = nullptr;
+    Rectangle rect {};
+    /// Clip sources to `rect`, so that atlas regions never sample their neighbours
+    bool clip = false;
+
+    /// Maps rectangle relative to the image into page coordinates. Negative sizes flip, as in raylib
+    [[nodiscard]] auto map(Rectangle source) const noexcept -> Rectangle {
+        if (!clip) return {rect.x + source.x, rect.y + source.y, source.width, source.height};
+        const auto x0 = std::clamp(source.x, 0.0f, rect.width);
+        const auto y0 = std::clamp(source.y, 0.0f, rect.height);
+        const auto x1 = std::clamp(source.x + std::abs(source.width), 0.0f, rect.width);
+        const auto y1 = std::clamp(source.y + std::abs(source.height), 0.0f, rect.height);
+        return {rect.x + x0, rect.y + y0, std::copysign(x1 - x0, source.width), std::copysign(y1 - y0, source.height)};
+    }
+};
+
 class JSTexture: public JSClass<JSTexture> {
   public:
     auto get_texture(JSContext *ctx) const noexcept -> const rl::Texture& {
@@ -35,15 +60,16 @@ class JSTexture: public JSClass<JSTexture> {
         return e.texture_store().borrow(_handle);
     }
 
-    auto get_source(JSContext *ctx) const noexcept -> JSValue {
+    /// Texture with the part of it that belongs to this image
+    auto get_region(JSContext *ctx) const noexcept -> TextureRegion {
         auto& tex = get_texture(ctx);
-        return JSRectangle::create_instance(
-            ctx,
-            0.0f,
-            0.0f,
-            static_cast<float>(tex.width),
-            static_cast<float>(tex.height)
-        );
+        if (_region) return {.texture = &tex, .rect = *_region, .clip = true};
+        return {.texture = &tex, .rect = {0.0f, 0.0f, static_cast<float>(tex.width), static_cast<float>(tex.height)}};
+    }
+
+    auto get_source(JSContext *ctx) const noexcept -> JSValue {
+        const auto region = get_region(ctx);
+        return JSRectangle::create_instance(ctx, 0.0f, 0.0f, region.rect.width, region.rect.height);
     }
 
     auto to_string(JSContext *ctx) const noexcept -> std::string {
@@ -51,6 +77,8 @@ class JSTexture: public JSClass<JSTexture> {
         return fmt::format("{}", tex);
     }
 
+    [[nodiscard]] auto handle() const noexcept -> ResourceStore<TextureData>::Handle { return _handle; }
+
     auto unload(JSContext *ctx) noexcept -> void {
         auto& e = Engine::get(ctx);
         e.texture_store().release(_handle);
@@ -58,6 +86,8 @@ class JSTexture: public JSClass<JSTexture> {
 
   private:
     ResourceStore<TextureData>::Handle _handle {};
+    /// Set when texture is a region of an atlas page
+    std::optional<Rectangle> _region {};
 
     static auto custom_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
         -> JSValue;
@@ -67,10 +97,23 @@ class JSTexture: public JSClass<JSTexture> {
     static auto read_texture_options_from_args(JSContext *ctx, int argc, JSValueConst *argv) noexcept
         -> JSResult<JSTextureLoadMode>;
 
+    /// Takes reference to atlas page holding image `name`, if it was packed
+    static auto load_from_atlas(JSContext *ctx, const std::string& name) noexcept
+        -> std::optional<std::pair<ResourceStore<TextureData>::Handle, Rectangle>>;
+
+    /// `Texture.atlas(paths, options?)`: packs images into shared pages, returns number of new pages
+    static auto build_atlas(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept -> JSValue;
+
+    /// `Texture.load(path | options)`: reads and decodes on loader workers, uploads on main thread
+    static auto load_async(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept -> JSValue;
+
   public: // JSClass implementation
     constexpr static auto class_name = "Texture";
 
-    inline static auto static_properties = PropertyList {};
+    inline static auto static_properties = PropertyList {
+        cfunc_def("load", 1, &JSTexture::load_async),
+        cfunc_def("atlas", 2, &JSTexture::build_atlas),
+    };
 
     inline static auto instance_properties = PropertyList {
         export_get_only<&JSTexture::get_source>("source"),
@@ -84,7 +127,10 @@ class JSTexture: public JSClass<JSTexture> {
     //       1. Extend JSClass to support custom constructor functions
     //       2. Add variant support to handle string | TextureOptions overloading
     //       3. Make initialize() take a variant parameter
-    auto initialize(ResourceStore<TextureData>::Handle handle) noexcept { _handle = handle; }
+    auto initialize(ResourceStore<TextureData>::Handle handle, std::optional<Rectangle> region) noexcept {
+        _handle = handle;
+        _region = region;
+    }
 
     //  TODO: Integrate this into JSClass framework
     constexpr static JSCFunction *constructor = &custom_constructor;
@@ -111,7 +157,9 @@ inline auto texture_module(JSContext *ctx) -> JSModuleDef * {
 namespace glint::js {
 
 using plugins::core::JSTexture;
+using plugins::core::JSTextureAtlasOptions;
 using plugins::core::JSTextureOptions;
+using plugins::core::TextureRegion;
 
 template<>
 inline auto convert_from_js<JSTexture *>(const Value& val) noexcept -> JSResult<JSTexture *> {
@@ -124,6 +172,25 @@ inline auto convert_from_js<const rl::Texture *>(const Value& val) noexcept -> J
     return JSError::type_error(val.ctx(), "Not an instance of Texture");
 }
 
+template<>
+inline auto convert_from_js<TextureRegion>(const Value& val) noexcept -> JSResult<TextureRegion> {
+    if (auto r = convert_from_js<JSTexture *>(val)) return (*r)->get_region(val.ctx());
+    return JSError::type_error(val.ctx(), "Not an instance of Texture");
+}
+
+template<>
+inline auto convert_from_js<JSTextureAtlasOptions>(const Value& val) noexcept -> JSResult<JSTextureAtlasOptions> {
+    auto o = JSTextureAtlasOptions {};
+    auto obj = Object::from_value(val);
+    if (!obj) return obj.error();
+
+    if (auto v = obj->at<std::optional<int>>("pageSize"); v) o.page_size = *v;
+    else return v.error();
+    if (auto v = obj->at<std::optional<int>>("padding"); v) o.padding = *v;
+    else return v.error();
+    return o;
+}
+
 template<>
 inline auto convert_from_js<JSTextureOptions>(const Value& val) noexcept -> JSResult<JSTextureOptions> try {
     auto o = JSTextureOptions {};
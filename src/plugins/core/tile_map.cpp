@@ -0,0 +1,246 @@
+#include <plugins/core/tile_map.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <plugins/core/sprite_batch.hpp>
+
+namespace glint::plugins::core {
+
+auto JSTileMap::initialize(
+    JSValue tileset,
+    JSValue tiles,
+    int columns,
+    int rows,
+    int tile_width,
+    int tile_height,
+    int chunk_size
+) noexcept -> void {
+    _tileset = tileset;
+    _tiles = tiles;
+    _columns = columns;
+    _rows = rows;
+    _tile_width = tile_width;
+    _tile_height = tile_height;
+    _chunk_size = chunk_size;
+    _chunk_columns = (columns + chunk_size - 1) / chunk_size;
+    _chunk_rows = (rows + chunk_size - 1) / chunk_size;
+    _chunks.resize(size_t(_chunk_columns) * size_t(_chunk_rows));
+}
+
+auto JSTileMap::get(JSContext *ctx, int x, int y) const noexcept -> JSValue {
+    if (x < 0 || y < 0 || x >= _columns || y >= _rows) return JS_NewInt32(ctx, 0);
+    auto tiles = convert_from_js<std::span<const uint16_t>>(borrow(ctx, _tiles));
+    if (!tiles) return jsthrow(tiles.error());
+    const auto index = size_t(y) * size_t(_columns) + size_t(x);
+    return JS_NewInt32(ctx, index < tiles->size() ? (*tiles)[index] : 0);
+}
+
+auto JSTileMap::set(JSContext *ctx, JSValueConst this_val, int x, int y, int tile) noexcept -> JSValue {
+    if (x < 0 || y < 0 || x >= _columns || y >= _rows) {
+        return jsthrow(JSError::range_error(ctx, fmt::format("Tile {}, {} is out of bounds", x, y)));
+    }
+    if (tile < 0 || tile > UINT16_MAX) {
+        return jsthrow(JSError::range_error(ctx, fmt::format("Invalid tile index {}", tile)));
+    }
+    auto tiles = convert_from_js<std::span<uint16_t>>(borrow(ctx, _tiles));
+    if (!tiles) return jsthrow(tiles.error());
+    const auto index = size_t(y) * size_t(_columns) + size_t(x);
+    if (index >= tiles->size()) return jsthrow(JSError::range_error(ctx, "TileMap tiles buffer is detached"));
+
+    if ((*tiles)[index] != tile) {
+        (*tiles)[index] = uint16_t(tile);
+        _chunks[size_t(y / _chunk_size) * size_t(_chunk_columns) + size_t(x / _chunk_size)].dirty = true;
+    }
+    return JS_DupValue(ctx, this_val);
+}
+
+auto JSTileMap::invalidate(
+    JSContext *ctx,
+    JSValueConst this_val,
+    std::optional<int> x,
+    std::optional<int> y,
+    std::optional<int> width,
+    std::optional<int> height
+) noexcept -> JSValue {
+    if (width.value_or(0) < 0 || height.value_or(0) < 0) {
+        const auto message = fmt::format("Invalid size {}x{}", width.value_or(0), height.value_or(0));
+        return jsthrow(JSError::range_error(ctx, message));
+    }
+    // Summed in 64 bits, so that rectangles reaching past INT32_MAX are clipped rather than wrapped
+    const auto left = std::max(int64_t(x.value_or(0)), int64_t {0});
+    const auto top = std::max(int64_t(y.value_or(0)), int64_t {0});
+    const auto right = std::min(int64_t(x.value_or(0)) + int64_t(width.value_or(_columns)), int64_t(_columns));
+    const auto bottom = std::min(int64_t(y.value_or(0)) + int64_t(height.value_or(_rows)), int64_t(_rows));
+    if (left >= right || top >= bottom) return JS_DupValue(ctx, this_val);
+
+    const auto x0 = int(left) / _chunk_size;
+    const auto y0 = int(top) / _chunk_size;
+    const auto x1 = int(right - 1) / _chunk_size;
+    const auto y1 = int(bottom - 1) / _chunk_size;
+    for (auto cy = y0; cy <= y1; cy++) {
+        for (auto cx = x0; cx <= x1; cx++) {
+            _chunks[size_t(cy) * size_t(_chunk_columns) + size_t(cx)].dirty = true;
+        }
+    }
+    return JS_DupValue(ctx, this_val);
+}
+
+auto JSTileMap::draw(JSContext *ctx, JSValueConst this_val, std::optional<Camera2D> camera) noexcept -> JSValue {
+    _drawn = 0;
+    SPDLOG_TRACE("Drawing {}", to_string());
+    if (!IsWindowReady() || _chunks.empty()) return JS_DupValue(ctx, this_val);
+
+    auto tiles = convert_from_js<std::span<const uint16_t>>(borrow(ctx, _tiles));
+    if (!tiles) return jsthrow(tiles.error());
+    if (tiles->size() < size_t(_columns) * size_t(_rows)) {
+        return jsthrow(JSError::range_error(ctx, "TileMap tiles buffer is detached"));
+    }
+    auto tileset = convert_from_js<TextureRegion>(borrow(ctx, _tileset));
+    if (!tileset) return jsthrow(tileset.error());
+
+    const auto chunk_width = float(_chunk_size * _tile_width);
+    const auto chunk_height = float(_chunk_size * _tile_height);
+    const auto screen_width = float(GetScreenWidth());
+    const auto screen_height = float(GetScreenHeight());
+    const auto view = camera ? visible_rect(*camera, screen_width, screen_height)
+                             : Rectangle {.x = 0.0f, .y = 0.0f, .width = screen_width, .height = screen_height};
+
+    const auto x0 = std::max(int(std::floor(view.x / chunk_width)), 0);
+    const auto y0 = std::max(int(std::floor(view.y / chunk_height)), 0);
+    const auto x1 = std::min(int(std::floor((view.x + view.width) / chunk_width)), _chunk_columns - 1);
+    const auto y1 = std::min(int(std::floor((view.y + view.height) / chunk_height)), _chunk_rows - 1);
+    if (x0 > x1 || y0 > y1) return JS_DupValue(ctx, this_val);
+
+    // Sprites recorded so far belong below the map, and switching render targets would lose their transform
+    flush(sprite_batch(), Engine::get(ctx).texture_store());
+
+    // Mark every visible chunk first, so rebuilding one never evicts another visible one
+    _draws++;
+    for (auto cy = y0; cy <= y1; cy++) {
+        for (auto cx = x0; cx <= x1; cx++) {
+            _chunks[size_t(cy) * size_t(_chunk_columns) + size_t(cx)].last_used = _draws;
+        }
+    }
+    for (auto cy = y0; cy <= y1; cy++) {
+        for (auto cx = x0; cx <= x1; cx++) {
+            auto& chunk = _chunks[size_t(cy) * size_t(_chunk_columns) + size_t(cx)];
+            if (chunk.dirty || chunk.texture.id == 0) rebuild(chunk, cx, cy, *tileset, *tiles);
+        }
+    }
+
+    if (camera) BeginMode2D(*camera);
+    for (auto cy = y0; cy <= y1; cy++) {
+        for (auto cx = x0; cx <= x1; cx++) {
+            const auto& chunk = _chunks[size_t(cy) * size_t(_chunk_columns) + size_t(cx)];
+            // Render textures are stored upside down
+            const auto source = Rectangle {.x = 0.0f, .y = 0.0f, .width = chunk_width, .height = -chunk_height};
+            const auto position = Vector2 {.x = float(cx) * chunk_width, .y = float(cy) * chunk_height};
+            DrawTextureRec(chunk.texture.texture, source, position, WHITE);
+            _drawn++;
+        }
+    }
+    if (camera) EndMode2D();
+
+    return JS_DupValue(ctx, this_val);
+}
+
+auto JSTileMap::rebuild(
+    Chunk& chunk,
+    int cx,
+    int cy,
+    const TextureRegion& tileset,
+    std::span<const uint16_t> tiles
+) noexcept -> void {
+    if (chunk.texture.id == 0) {
+        if (_cached >= _max_cached) evict();
+        chunk.texture = rl::RenderTexture::load(_chunk_size * _tile_width, _chunk_size * _tile_height);
+        _cached++;
+    }
+
+    const auto tileset_columns = std::max(int(tileset.rect.width) / _tile_width, 1);
+    const auto tw = float(_tile_width);
+    const auto th = float(_tile_height);
+    BeginTextureMode(chunk.texture);
+    ClearBackground(BLANK);
+    for (auto y = cy * _chunk_size; y < std::min((cy + 1) * _chunk_size, _rows); y++) {
+        for (auto x = cx * _chunk_size; x < std::min((cx + 1) * _chunk_size, _columns); x++) {
+            const auto tile = int(tiles[size_t(y) * size_t(_columns) + size_t(x)]);
+            if (tile == 0) continue;
+            const auto cell = tile - 1;
+            const auto source = Rectangle {
+                .x = float(cell % tileset_columns) * tw,
+                .y = float(cell / tileset_columns) * th,
+                .width = tw,
+                .height = th,
+            };
+            const auto position = Vector2 {
+                .x = float(x - cx * _chunk_size) * tw,
+                .y = float(y - cy * _chunk_size) * th,
+            };
+            DrawTextureRec(*tileset.texture, tileset.map(source), position, WHITE);
+        }
+    }
+    EndTextureMode();
+    chunk.dirty = false;
+}
+
+auto JSTileMap::evict() noexcept -> void {
+    Chunk *oldest = nullptr;
+    for (auto& chunk : _chunks) {
+        if (chunk.texture.id == 0 || chunk.last_used >= _draws) continue;
+        if (oldest == nullptr || chunk.last_used < oldest->last_used) oldest = &chunk;
+    }
+    // Every cached chunk is visible: cache grows past the limit rather than thrash
+    if (oldest == nullptr) return;
+
+    oldest->texture = rl::RenderTexture {};
+    oldest->dirty = true;
+    _cached--;
+}
+
+auto JSTileMap::custom_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+    -> JSValue {
+    auto args = unpack_args<JSTexture *, int, int, int, int, std::optional<int>>(ctx, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [texture, columns, rows, tile_width, tile_height, chunk_size] = *args;
+    (void)texture;
+    if (columns <= 0 || rows <= 0 || int64_t(columns) * int64_t(rows) > int64_t(INT32_MAX)) {
+        return jsthrow(JSError::range_error(ctx, fmt::format("Invalid TileMap size {}x{}", columns, rows)));
+    }
+    if (tile_width <= 0 || tile_height <= 0 || std::max(tile_width, tile_height) > max_chunk_pixels) {
+        return jsthrow(JSError::range_error(ctx, fmt::format("Invalid tile size {}x{}", tile_width, tile_height)));
+    }
+    // Largest chunk whose render texture fits, default shrinks for large tiles
+    const auto max_chunk_size = max_chunk_pixels / std::max(tile_width, tile_height);
+    if (chunk_size && (*chunk_size <= 0 || *chunk_size > max_chunk_size)) {
+        return jsthrow(JSError::range_error(
+            ctx,
+            fmt::format("Chunk size must be between 1 and {} for {}x{} tiles", max_chunk_size, tile_width, tile_height)
+        ));
+    }
+
+    auto length = JS_NewInt64(ctx, int64_t(columns) * int64_t(rows));
+    auto tiles = JS_NewTypedArray(ctx, 1, &length, JS_TYPED_ARRAY_UINT16);
+    if (JS_IsException(tiles)) return tiles;
+
+    auto tileset = JS_DupValue(ctx, argv[0]);
+    auto obj = create_instance_this(
+        borrow(ctx, this_val),
+        tileset,
+        tiles,
+        columns,
+        rows,
+        tile_width,
+        tile_height,
+        chunk_size.value_or(std::min(32, max_chunk_size))
+    );
+    if (JS_IsUndefined(obj)) {
+        JS_FreeValue(ctx, tileset);
+        JS_FreeValue(ctx, tiles);
+        return JS_EXCEPTION;
+    }
+    return obj;
+}
+
+} // namespace glint::plugins::core
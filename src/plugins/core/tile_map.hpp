@@ -0,0 +1,171 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <engine.hpp>
+#include <plugins/core/camera.hpp>
+#include <plugins/core/texture.hpp>
+#include <quickjs.hpp>
+#include <raylib.hpp>
+
+namespace glint::plugins::core {
+
+using namespace js;
+
+/// Grid of tiles from one tileset texture. Tiles are rendered into per-chunk render textures once,
+/// then every frame only the chunks visible through the camera are drawn, one quad each
+class JSTileMap: public JSClass<JSTileMap> {
+  public:
+    [[nodiscard]] auto get_columns() const noexcept -> int { return _columns; }
+
+    [[nodiscard]] auto get_rows() const noexcept -> int { return _rows; }
+
+    [[nodiscard]] auto get_tile_width() const noexcept -> int { return _tile_width; }
+
+    [[nodiscard]] auto get_tile_height() const noexcept -> int { return _tile_height; }
+
+    [[nodiscard]] auto get_chunk_size() const noexcept -> int { return _chunk_size; }
+
+    [[nodiscard]] auto get_tiles(JSContext *ctx) const noexcept -> JSValue { return JS_DupValue(ctx, _tiles); }
+
+    [[nodiscard]] auto get_max_cached_chunks() const noexcept -> int { return _max_cached; }
+
+    auto set_max_cached_chunks(int max) noexcept -> void { _max_cached = std::max(max, 1); }
+
+    [[nodiscard]] auto get_cached_chunks() const noexcept -> int { return _cached; }
+
+    [[nodiscard]] auto get_drawn_chunks() const noexcept -> int { return _drawn; }
+
+    /// Tile at column `x` and row `y`, 0 when empty or out of bounds
+    auto get(JSContext *ctx, int x, int y) const noexcept -> JSValue;
+
+    /// Sets tile at column `x` and row `y` and marks its chunk for redraw
+    auto set(JSContext *ctx, JSValueConst this_val, int x, int y, int tile) noexcept -> JSValue;
+
+    /// Marks chunks overlapping tile rectangle for redraw, or all of them without arguments.
+    /// Needed after writing to `tiles` directly
+    auto invalidate(
+        JSContext *ctx,
+        JSValueConst this_val,
+        std::optional<int> x,
+        std::optional<int> y,
+        std::optional<int> width,
+        std::optional<int> height
+    ) noexcept -> JSValue;
+
+    /// Draws visible chunks through `camera`, redrawing dirty ones first. Must be called outside of camera
+    /// and texture mode, since rebuilding chunks switches render targets
+    auto draw(JSContext *ctx, JSValueConst this_val, std::optional<Camera2D> camera) noexcept -> JSValue;
+
+    [[nodiscard]] auto to_string() const noexcept -> std::string {
+        return fmt::format("TileMap({}x{}, {}x{}px)", _columns, _rows, _tile_width, _tile_height);
+    }
+
+    /// Longest chunk texture side in pixels, within the render texture size every supported GPU allows
+    static constexpr int max_chunk_pixels = 4096;
+
+  private:
+    struct Chunk {
+        /// Empty until the chunk is drawn for the first time and after eviction
+        rl::RenderTexture texture {};
+        bool dirty = true;
+        uint64_t last_used = 0;
+    };
+
+    /// Owned Texture
+    JSValue _tileset = JS_UNDEFINED;
+    /// Owned Uint16Array, `columns * rows` tile indices row by row. 0 is empty, n is tileset cell n - 1
+    JSValue _tiles = JS_UNDEFINED;
+    int _columns = 0;
+    int _rows = 0;
+    int _tile_width = 0;
+    int _tile_height = 0;
+    /// Tiles per chunk side
+    int _chunk_size = 32;
+    int _chunk_columns = 0;
+    int _chunk_rows = 0;
+    std::vector<Chunk> _chunks {};
+    /// Render textures kept at most, least recently drawn chunks are evicted first
+    int _max_cached = 64;
+    int _cached = 0;
+    /// Chunks drawn by last `draw`
+    int _drawn = 0;
+    uint64_t _draws = 0;
+
+    auto rebuild(Chunk& chunk, int cx, int cy, const TextureRegion& tileset, std::span<const uint16_t> tiles) noexcept
+        -> void;
+
+    /// Frees render texture of least recently used chunk not drawn by the current `draw`
+    auto evict() noexcept -> void;
+
+    static auto custom_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+        -> JSValue;
+
+  public: // JSClass implementation
+    constexpr static auto class_name = "TileMap";
+
+    inline static auto static_properties = PropertyList {};
+
+    inline static auto instance_properties = PropertyList {
+        export_get_only<&JSTileMap::get_columns>("columns"),
+        export_get_only<&JSTileMap::get_rows>("rows"),
+        export_get_only<&JSTileMap::get_tile_width>("tileWidth"),
+        export_get_only<&JSTileMap::get_tile_height>("tileHeight"),
+        export_get_only<&JSTileMap::get_chunk_size>("chunkSize"),
+        export_get_only<&JSTileMap::get_tiles>("tiles"),
+        export_getset<&JSTileMap::get_max_cached_chunks, &JSTileMap::set_max_cached_chunks>("maxCachedChunks"),
+        export_get_only<&JSTileMap::get_cached_chunks>("cachedChunks"),
+        export_get_only<&JSTileMap::get_drawn_chunks>("drawnChunks"),
+        export_method<&JSTileMap::get>("get"),
+        export_method<&JSTileMap::set>("set"),
+        export_method<&JSTileMap::invalidate>("invalidate"),
+        export_method<&JSTileMap::draw>("draw"),
+        export_method<&JSTileMap::to_string>("toString"),
+    };
+
+    /// Takes ownership of `tileset` and `tiles`
+    auto initialize(
+        JSValue tileset,
+        JSValue tiles,
+        int columns,
+        int rows,
+        int tile_width,
+        int tile_height,
+        int chunk_size
+    ) noexcept -> void;
+
+    constexpr static JSCFunction *constructor = &custom_constructor;
+
+    constexpr static JSClassFinalizer *class_finalizer = [](JSRuntime *rt, JSValueConst val) noexcept -> void {
+        auto ptr = static_cast<JSTileMap *>(JS_GetOpaque(val, JSTileMap::class_id(rt)));
+        if (ptr == nullptr) return;
+        // Context may be gone already when runtime is being freed
+        JS_FreeValueRT(rt, ptr->_tileset);
+        JS_FreeValueRT(rt, ptr->_tiles);
+        deallocate(ptr);
+    };
+
+    constexpr static JSClassGCMark *class_gc_mark = [](JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark) {
+        auto ptr = static_cast<JSTileMap *>(JS_GetOpaque(val, JSTileMap::class_id(rt)));
+        if (ptr == nullptr) return;
+        JS_MarkValue(rt, ptr->_tileset, mark);
+        JS_MarkValue(rt, ptr->_tiles, mark);
+    };
+};
+
+inline auto tile_map_module(JSContext *ctx) -> JSModuleDef * {
+    auto m = JS_NewCModule(ctx, "@glint/core/TileMap", [](auto ctx, auto m) -> int {
+        auto ctor = JSTileMap::define(ctx).take();
+        JS_SetModuleExport(ctx, m, "TileMap", JS_DupValue(ctx, ctor));
+        JS_SetModuleExport(ctx, m, "default", ctor);
+        return 0;
+    });
+
+    JS_AddModuleExport(ctx, m, "TileMap");
+    JS_AddModuleExport(ctx, m, "default");
+    return m;
+}
+
+} // namespace glint::plugins::core
@@ -246,6 +246,8 @@ class JSVector2: public JSClass<JSVector2> {
   public: // JSClass implementation
     constexpr static auto class_name = "Vector2";
 
+    constexpr static bool pooled = true;
+
     inline static auto static_properties = PropertyList {
         export_static_method<&JSVector2::zero>("zero"),
         export_static_method<&JSVector2::one>("one"),
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+
+#include <plugins/core/vector2.hpp>
+#include <quickjs.hpp>
+#include <raylib.hpp>
+
+namespace glint::plugins::core {
+
+using namespace js;
+
+/// Fixed number of vectors packed as `[x0, y0, x1, y1, ...]` in a Float32Array shared with JS
+class JSVector2Array: public JSClass<JSVector2Array> {
+  public:
+    [[nodiscard]] auto get_length() const noexcept -> uint32_t { return _length; }
+
+    [[nodiscard]] auto get_data(JSContext *ctx) const noexcept -> JSValue { return JS_DupValue(ctx, _data); }
+
+    /// Borrows vectors. Span is valid only until control returns to JS
+    auto vectors(JSContext *ctx) const noexcept -> JSResult<std::span<::Vector2>> {
+        auto floats = convert_from_js<std::span<float>>(borrow(ctx, _data));
+        if (!floats) return floats.error();
+        // Buffer may be detached by JS, in which case it reports zero length
+        const auto length = std::min(size_t(_length), floats->size() / 2);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): Vector2 is two packed floats
+        return std::span(reinterpret_cast<::Vector2 *>(floats->data()), length);
+    }
+
+    /// `get(index, out?)`: copies vector into `out` if given, otherwise into new Vector2
+    auto get(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) const noexcept -> JSValue {
+        auto vecs = vectors(ctx);
+        if (!vecs) return jsthrow(vecs.error());
+        auto index = at(ctx, *vecs, argc, argv);
+        if (!index) return jsthrow(index.error());
+
+        const auto v = (*vecs)[*index];
+        if (argc < 2 || JS_IsUndefined(argv[1])) return JSVector2::create_instance(ctx, v.x, v.y);
+
+        auto out = JSVector2::get_instance(borrow(ctx, argv[1]));
+        if (!out) return jsthrow(out.error());
+        (*out)->initialize(v.x, v.y);
+        return JS_DupValue(ctx, argv[1]);
+    }
+
+    /// `set(index, vector)` or `set(index, x, y)`
+    auto set(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept -> JSValue {
+        auto vecs = vectors(ctx);
+        if (!vecs) return jsthrow(vecs.error());
+        auto index = at(ctx, *vecs, argc, argv);
+        if (!index) return jsthrow(index.error());
+        auto v = read_vector_from_args(ctx, argc - 1, argv + 1);
+        if (!v) return jsthrow(v.error());
+
+        (*vecs)[*index] = *v;
+        return JS_DupValue(ctx, this_val);
+    }
+
+    /// `fill(vector)` or `fill(x, y)`
+    auto fill(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept -> JSValue {
+        auto vecs = vectors(ctx);
+        if (!vecs) return jsthrow(vecs.error());
+        auto v = read_vector_from_args(ctx, argc, argv);
+        if (!v) return jsthrow(v.error());
+
+        std::ranges::fill(*vecs, *v);
+        return JS_DupValue(ctx, this_val);
+    }
+
+    /// Adds `other[i] * scale` to every vector, e.g. `positions.addScaled(velocities, screen.dt)`
+    auto add_scaled(JSContext *ctx, JSValueConst this_val, JSVector2Array *other, float scale) noexcept -> JSValue {
+        auto vecs = vectors(ctx);
+        if (!vecs) return jsthrow(vecs.error());
+        auto others = other->vectors(ctx);
+        if (!others) return jsthrow(others.error());
+        if (others->size() != vecs->size()) {
+            return jsthrow(JSError::range_error(ctx, "Vector2Array lengths do not match"));
+        }
+
+        for (auto i = size_t {0}; i < vecs->size(); i++) {
+            (*vecs)[i].x += (*others)[i].x * scale;
+            (*vecs)[i].y += (*others)[i].y * scale;
+        }
+        return JS_DupValue(ctx, this_val);
+    }
+
+    [[nodiscard]] auto to_string() const noexcept -> std::string {
+        return fmt::format("Vector2Array({})", _length);
+    }
+
+  private:
+    /// Owned Float32Array
+    JSValue _data = JS_UNDEFINED;
+    uint32_t _length = 0;
+
+    static auto at(JSContext *ctx, std::span<::Vector2> vecs, int argc, JSValueConst *argv) noexcept
+        -> JSResult<size_t> {
+        if (argc < 1) return JSError::type_error(ctx, "Index is required");
+        auto index = convert_from_js<double>(borrow(ctx, argv[0]));
+        if (!index) return index.error();
+        // Written so that NaN fails too
+        if (!(*index >= 0 && *index < double(vecs.size()))) {
+            return JSError::range_error(ctx, fmt::format("Index {} is out of bounds", *index));
+        }
+        return size_t(*index);
+    }
+
+    static auto custom_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+        -> JSValue {
+        auto args = unpack_args<double>(ctx, argc, argv);
+        if (!args) return jsthrow(args.error());
+        const auto [length] = *args;
+        if (length < 0 || length > double(UINT32_MAX / 2)) {
+            return jsthrow(JSError::range_error(ctx, "Invalid Vector2Array length"));
+        }
+
+        auto floats = JS_NewInt64(ctx, int64_t(length) * 2);
+        auto data = JS_NewTypedArray(ctx, 1, &floats, JS_TYPED_ARRAY_FLOAT32);
+        if (JS_IsException(data)) return data;
+
+        auto obj = create_instance_this(borrow(ctx, this_val), data, uint32_t(length));
+        if (JS_IsUndefined(obj)) {
+            JS_FreeValue(ctx, data);
+            return JS_EXCEPTION;
+        }
+        return obj;
+    }
+
+  public: // JSClass implementation
+    constexpr static auto class_name = "Vector2Array";
+
+    inline static auto static_properties = PropertyList {};
+
+    inline static auto instance_properties = PropertyList {
+        export_get_only<&JSVector2Array::get_length>("length"),
+        export_get_only<&JSVector2Array::get_data>("data"),
+        export_method<&JSVector2Array::get>("get"),
+        export_method<&JSVector2Array::set>("set"),
+        export_method<&JSVector2Array::fill>("fill"),
+        export_method<&JSVector2Array::add_scaled>("addScaled"),
+        export_method<&JSVector2Array::to_string>("toString"),
+    };
+
+    /// Takes ownership of `data`
+    auto initialize(JSValue data, uint32_t length) noexcept {
+        _data = data;
+        _length = length;
+    }
+
+    constexpr static JSCFunction *constructor = &custom_constructor;
+
+    constexpr static JSClassFinalizer *class_finalizer = [](JSRuntime *rt, JSValueConst val) noexcept -> void {
+        auto ptr = static_cast<JSVector2Array *>(JS_GetOpaque(val, JSVector2Array::class_id(rt)));
+        if (ptr == nullptr) return;
+        // Context may be gone already when runtime is being freed
+        JS_FreeValueRT(rt, ptr->_data);
+        deallocate(ptr);
+    };
+
+    constexpr static JSClassGCMark *class_gc_mark = [](JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark) {
+        auto ptr = static_cast<JSVector2Array *>(JS_GetOpaque(val, JSVector2Array::class_id(rt)));
+        if (ptr != nullptr) JS_MarkValue(rt, ptr->_data, mark);
+    };
+};
+
+inline auto vector2_array_module(JSContext *ctx) -> JSModuleDef * {
+    auto m = JS_NewCModule(ctx, "@glint/core/Vector2Array", [](auto ctx, auto m) -> int {
+        auto ctor = JSVector2Array::define(ctx).take();
+        JS_SetModuleExport(ctx, m, "Vector2Array", JS_DupValue(ctx, ctor));
+        JS_SetModuleExport(ctx, m, "default", ctor);
+        return 0;
+    });
+
+    JS_AddModuleExport(ctx, m, "Vector2Array");
+    JS_AddModuleExport(ctx, m, "default");
+    return m;
+}
+
+} // namespace glint::plugins::core
+
+namespace glint::js {
+
+using plugins::core::JSVector2Array;
+
+template<>
+inline auto convert_from_js<JSVector2Array *>(const Value& val) noexcept -> JSResult<JSVector2Array *> {
+    return JSVector2Array::get_instance(val);
+}
+
+} // namespace glint::js
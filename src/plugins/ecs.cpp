@@ -0,0 +1,2 @@
+#include "ecs/storage.cpp"
+#include "ecs/world.cpp"
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <plugins/ecs/world.hpp>
+
+namespace glint::plugins::ecs {
+
+constexpr static char ECS_MODULE[] = {
+#include "ecs_module.js.h"
+};
+
+auto plugin(JSContext *ctx) -> EnginePlugin {
+    return EnginePlugin {
+        .name = "ecs",
+        .c_modules =
+            {
+                {"@glint/ecs/World", world_module(ctx)},
+            },
+        .js_modules =
+            {
+                {"@glint/ecs", ECS_MODULE},
+            },
+    };
+}
+
+} // namespace glint::plugins::ecs
@@ -0,0 +1,234 @@
+#include <plugins/ecs/storage.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <fmt/format.h>
+
+namespace glint::plugins::ecs {
+
+namespace {
+
+constexpr auto index_mask = Entity((1u << entity_index_bits) - 1);
+
+auto index_of(Entity entity) noexcept -> uint32_t {
+    return entity & index_mask;
+}
+
+auto generation_of(Entity entity) noexcept -> uint32_t {
+    return entity >> entity_index_bits;
+}
+
+/// Table of entities having exactly the components of `mask`, created on first use
+auto table_for(Storage& self, uint64_t mask) -> uint32_t {
+    if (auto it = self.table_by_mask.find(mask); it != self.table_by_mask.end()) return it->second;
+
+    auto table = Table {.mask = mask};
+    for (auto bits = mask; bits != 0; bits &= bits - 1) {
+        const auto id = uint32_t(std::countr_zero(bits));
+        table.components.push_back(id);
+        table.first_column.push_back(table.columns.size());
+        for (const auto& f : self.components[id].fields) {
+            table.columns.push_back(Column {.type = f.type});
+        }
+    }
+
+    const auto index = uint32_t(self.tables.size());
+    self.tables.push_back(std::move(table));
+    self.table_by_mask.insert({mask, index});
+    return index;
+}
+
+/// Appends zeroed row for `entity`
+auto push_row(Table& table, Entity entity) -> uint32_t {
+    const auto row = table.entities.size();
+    for (auto& c : table.columns) {
+        const auto size = field_size(c.type);
+        if (row == c.capacity) {
+            // Views of the old block keep it alive, so it is replaced instead of resized in place
+            const auto capacity = std::max(c.capacity * 2, size_t {16});
+            auto data = std::make_shared<std::byte[]>(capacity * size);
+            if (row > 0) std::memcpy(data.get(), c.data.get(), row * size);
+            c.data = std::move(data);
+            c.capacity = capacity;
+        }
+        std::memset(c.data.get() + row * size, 0, size);
+    }
+    table.entities.push_back(entity);
+    return uint32_t(row);
+}
+
+/// Removes `row` by moving the last row into it. Returns entity that moved, if any
+auto swap_remove(Table& table, uint32_t row) -> std::optional<Entity> {
+    const auto last = uint32_t(table.entities.size() - 1);
+    if (row != last) {
+        for (auto& c : table.columns) {
+            const auto size = field_size(c.type);
+            std::memcpy(c.data.get() + row * size, c.data.get() + last * size, size);
+        }
+    }
+    table.entities[row] = table.entities[last];
+    table.entities.pop_back();
+    if (row == last) return std::nullopt;
+    return table.entities[row];
+}
+
+/// Moves `entity` into table of `mask`, copying components both tables have
+auto move_entity(Storage& self, Entity entity, uint64_t mask) -> void {
+    const auto index = index_of(entity);
+    const auto from_index = self.locations[index].table;
+    const auto from_row = self.locations[index].row;
+    const auto to_index = table_for(self, mask);
+    // Creating the table may have reallocated `tables`
+    auto& from = self.tables[from_index];
+    auto& to = self.tables[to_index];
+
+    const auto to_row = push_row(to, entity);
+    for (size_t i = 0; i < to.components.size(); i++) {
+        const auto src = from.find(to.components[i]);
+        if (!src) continue;
+        const auto fields = self.components[to.components[i]].fields.size();
+        for (size_t f = 0; f < fields; f++) {
+            auto& dst_col = to.columns[to.first_column[i] + f];
+            const auto& src_col = from.columns[from.first_column[*src] + f];
+            const auto size = field_size(dst_col.type);
+            std::memcpy(dst_col.data.get() + to_row * size, src_col.data.get() + from_row * size, size);
+        }
+    }
+
+    if (auto moved = swap_remove(from, from_row)) self.locations[index_of(*moved)].row = from_row;
+    self.locations[index] = {.table = to_index, .row = to_row};
+    self.version++;
+}
+
+} // namespace
+
+auto field_type_from_name(std::string_view name) noexcept -> std::optional<FieldType> {
+    if (name == "f32") return FieldType::f32;
+    if (name == "f64") return FieldType::f64;
+    if (name == "i8") return FieldType::i8;
+    if (name == "u8") return FieldType::u8;
+    if (name == "i16") return FieldType::i16;
+    if (name == "u16") return FieldType::u16;
+    if (name == "i32") return FieldType::i32;
+    if (name == "u32") return FieldType::u32;
+    return std::nullopt;
+}
+
+auto field_size(FieldType type) noexcept -> size_t {
+    switch (type) {
+    case FieldType::f64: return 8;
+    case FieldType::f32:
+    case FieldType::i32:
+    case FieldType::u32: return 4;
+    case FieldType::i16:
+    case FieldType::u16: return 2;
+    case FieldType::i8:
+    case FieldType::u8: return 1;
+    }
+    return 1;
+}
+
+auto Table::find(uint32_t component) const noexcept -> std::optional<size_t> {
+    const auto it = std::ranges::lower_bound(components, component);
+    if (it == components.end() || *it != component) return std::nullopt;
+    return size_t(it - components.begin());
+}
+
+auto define_component(Storage& self, Component component) -> Result<uint32_t> {
+    if (self.components.size() >= max_components) {
+        return err(fmt::format("Cannot define more than {} components", max_components));
+    }
+    if (component.fields.empty()) return err(fmt::format("Component '{}' has no fields", component.name));
+    self.components.push_back(std::move(component));
+    return uint32_t(self.components.size() - 1);
+}
+
+auto create(Storage& self) -> Result<Entity> {
+    auto index = uint32_t {};
+    if (!self.free_slots.empty()) {
+        index = self.free_slots.back();
+        self.free_slots.pop_back();
+    } else {
+        if (self.generations.size() >= max_entities) {
+            return err(fmt::format("Cannot create more than {} entities", max_entities));
+        }
+        index = uint32_t(self.generations.size());
+        self.generations.push_back(0);
+        self.locations.push_back({});
+        self.alive.push_back(false);
+    }
+
+    const auto entity = Entity((self.generations[index] << entity_index_bits) | index);
+    const auto table = table_for(self, 0);
+    const auto row = push_row(self.tables[table], entity);
+    self.locations[index] = {.table = table, .row = row};
+    self.alive[index] = true;
+    self.count++;
+    self.version++;
+    return entity;
+}
+
+auto destroy(Storage& self, Entity entity) -> Result<> {
+    if (!is_alive(self, entity)) return err(fmt::format("Entity {} is not alive", entity));
+    const auto index = index_of(entity);
+    const auto [table, row] = self.locations[index];
+    if (auto moved = swap_remove(self.tables[table], row)) self.locations[index_of(*moved)].row = row;
+
+    self.alive[index] = false;
+    // Generation wraps around within the bits left by the index
+    self.generations[index] = (self.generations[index] + 1) & ((1u << (32 - entity_index_bits)) - 1);
+    self.free_slots.push_back(index);
+    self.count--;
+    self.version++;
+    return {};
+}
+
+auto is_alive(const Storage& self, Entity entity) noexcept -> bool {
+    const auto index = index_of(entity);
+    return index < self.generations.size() && self.alive[index] && self.generations[index] == generation_of(entity);
+}
+
+auto has(const Storage& self, Entity entity, uint32_t component) noexcept -> bool {
+    if (!is_alive(self, entity) || component >= self.components.size()) return false;
+    return (self.tables[self.locations[index_of(entity)].table].mask & (uint64_t {1} << component)) != 0;
+}
+
+auto add(Storage& self, Entity entity, uint32_t component) -> Result<> {
+    if (!is_alive(self, entity)) return err(fmt::format("Entity {} is not alive", entity));
+    if (component >= self.components.size()) return err(fmt::format("Unknown component {}", component));
+    const auto mask = self.tables[self.locations[index_of(entity)].table].mask;
+    const auto bit = uint64_t {1} << component;
+    if ((mask & bit) == 0) move_entity(self, entity, mask | bit);
+    return {};
+}
+
+auto remove(Storage& self, Entity entity, uint32_t component) -> Result<> {
+    if (!is_alive(self, entity)) return err(fmt::format("Entity {} is not alive", entity));
+    if (component >= self.components.size()) return err(fmt::format("Unknown component {}", component));
+    const auto mask = self.tables[self.locations[index_of(entity)].table].mask;
+    const auto bit = uint64_t {1} << component;
+    if ((mask & bit) != 0) move_entity(self, entity, mask & ~bit);
+    return {};
+}
+
+auto field(Storage& self, Entity entity, uint32_t component, size_t field) noexcept -> std::byte * {
+    if (!has(self, entity, component)) return nullptr;
+    const auto [table_index, row] = self.locations[index_of(entity)];
+    auto& table = self.tables[table_index];
+    const auto position = table.find(component);
+    if (!position || field >= self.components[component].fields.size()) return nullptr;
+    auto& column = table.columns[table.first_column[*position] + field];
+    return column.data.get() + row * field_size(column.type);
+}
+
+auto matching(const Storage& self, uint64_t mask) -> std::vector<uint32_t> {
+    auto tables = std::vector<uint32_t> {};
+    for (size_t i = 0; i < self.tables.size(); i++) {
+        if ((self.tables[i].mask & mask) == mask) tables.push_back(uint32_t(i));
+    }
+    return tables;
+}
+
+} // namespace glint::plugins::ecs
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <error.hpp>
+
+namespace glint::plugins::ecs {
+
+/// Numeric type of a component field, named after typed arrays
+enum class FieldType : uint8_t { f32, f64, i8, u8, i16, u16, i32, u32 };
+
+[[nodiscard]] auto field_type_from_name(std::string_view name) noexcept -> std::optional<FieldType>;
+
+[[nodiscard]] auto field_size(FieldType type) noexcept -> size_t;
+
+struct Field {
+    std::string name;
+    FieldType type;
+};
+
+struct Component {
+    std::string name;
+    std::vector<Field> fields {};
+};
+
+/// Components a world can have at most, so sets of them fit in a bit mask
+constexpr auto max_components = size_t {64};
+
+/// Entity handle: slot index in the low bits, slot generation in the high ones, so stale handles are detected
+using Entity = uint32_t;
+
+constexpr auto entity_index_bits = 20;
+constexpr auto max_entities = size_t {1} << entity_index_bits;
+
+/// Values of one field of one component for every row of a table
+struct Column {
+    FieldType type;
+    /// Shared with typed arrays handed to JS, so they stay readable after the column grows or the world is gone
+    std::shared_ptr<std::byte[]> data {};
+    /// Rows that fit into `data`
+    size_t capacity = 0;
+};
+
+/// Archetype: entities having exactly the same set of components. Each field is a separate column,
+/// so iterating one field touches only contiguous memory
+struct Table {
+    uint64_t mask = 0;
+    /// Component ids in ascending order
+    std::vector<uint32_t> components {};
+    /// Index of the first column of every component
+    std::vector<size_t> first_column {};
+    std::vector<Column> columns {};
+    std::vector<Entity> entities {};
+
+    [[nodiscard]] auto size() const noexcept -> size_t { return entities.size(); }
+
+    /// Position of `component` in `components`
+    [[nodiscard]] auto find(uint32_t component) const noexcept -> std::optional<size_t>;
+};
+
+/// Entities and their components, stored by archetype
+struct Storage {
+    struct Location {
+        uint32_t table = 0;
+        uint32_t row = 0;
+    };
+
+    std::vector<Component> components {};
+    std::vector<Table> tables {};
+    std::unordered_map<uint64_t, uint32_t> table_by_mask {};
+    std::vector<uint32_t> generations {};
+    std::vector<Location> locations {};
+    std::vector<bool> alive {};
+    std::vector<uint32_t> free_slots {};
+    size_t count = 0;
+    /// Incremented on every change of table rows, after which pointers into columns must not be used
+    uint64_t version = 0;
+};
+
+auto define_component(Storage& self, Component component) -> Result<uint32_t>;
+
+auto create(Storage& self) -> Result<Entity>;
+
+auto destroy(Storage& self, Entity entity) -> Result<>;
+
+[[nodiscard]] auto is_alive(const Storage& self, Entity entity) noexcept -> bool;
+
+[[nodiscard]] auto has(const Storage& self, Entity entity, uint32_t component) noexcept -> bool;
+
+/// Adds zeroed `component` to `entity`, does nothing when it already has one
+auto add(Storage& self, Entity entity, uint32_t component) -> Result<>;
+
+auto remove(Storage& self, Entity entity, uint32_t component) -> Result<>;
+
+/// Value of `field` of `component` of `entity`, null when the entity does not have it
+[[nodiscard]] auto field(Storage& self, Entity entity, uint32_t component, size_t field) noexcept -> std::byte *;
+
+/// Tables having every component of `mask`
+[[nodiscard]] auto matching(const Storage& self, uint64_t mask) -> std::vector<uint32_t>;
+
+} // namespace glint::plugins::ecs
@@ -0,0 +1,395 @@
+#include <plugins/ecs/world.hpp>
+
+#include <array>
+#include <cstring>
+#include <span>
+
+#include <defer.hpp>
+
+#include <engine/window.hpp>
+#include <plugins/core/culling.hpp>
+#include <plugins/core/sprite_batch.hpp>
+
+namespace glint::plugins::ecs {
+
+namespace {
+
+auto typed_array_type(FieldType type) noexcept -> JSTypedArrayEnum {
+    switch (type) {
+    case FieldType::f32: return JS_TYPED_ARRAY_FLOAT32;
+    case FieldType::f64: return JS_TYPED_ARRAY_FLOAT64;
+    case FieldType::i8: return JS_TYPED_ARRAY_INT8;
+    case FieldType::u8: return JS_TYPED_ARRAY_UINT8;
+    case FieldType::i16: return JS_TYPED_ARRAY_INT16;
+    case FieldType::u16: return JS_TYPED_ARRAY_UINT16;
+    case FieldType::i32: return JS_TYPED_ARRAY_INT32;
+    case FieldType::u32: return JS_TYPED_ARRAY_UINT32;
+    }
+    return JS_TYPED_ARRAY_UINT8;
+}
+
+template<typename T>
+auto store(std::byte *dst, double value) noexcept -> void {
+    const auto v = static_cast<T>(value);
+    std::memcpy(dst, &v, sizeof(T));
+}
+
+template<typename T>
+auto load(const std::byte *src) noexcept -> double {
+    auto v = T {};
+    std::memcpy(&v, src, sizeof(T));
+    return static_cast<double>(v);
+}
+
+auto write_value(std::byte *dst, FieldType type, double value) noexcept -> void {
+    switch (type) {
+    case FieldType::f32: return store<float>(dst, value);
+    case FieldType::f64: return store<double>(dst, value);
+    case FieldType::i8: return store<int8_t>(dst, value);
+    case FieldType::u8: return store<uint8_t>(dst, value);
+    case FieldType::i16: return store<int16_t>(dst, value);
+    case FieldType::u16: return store<uint16_t>(dst, value);
+    case FieldType::i32: return store<int32_t>(dst, value);
+    case FieldType::u32: return store<uint32_t>(dst, value);
+    }
+}
+
+auto read_value(const std::byte *src, FieldType type) noexcept -> double {
+    switch (type) {
+    case FieldType::f32: return load<float>(src);
+    case FieldType::f64: return load<double>(src);
+    case FieldType::i8: return load<int8_t>(src);
+    case FieldType::u8: return load<uint8_t>(src);
+    case FieldType::i16: return load<int16_t>(src);
+    case FieldType::u16: return load<uint16_t>(src);
+    case FieldType::i32: return load<int32_t>(src);
+    case FieldType::u32: return load<uint32_t>(src);
+    }
+    return 0.0;
+}
+
+auto mask_of(std::span<const uint32_t> components) noexcept -> uint64_t {
+    auto mask = uint64_t {};
+    for (const auto c : components) mask |= uint64_t {1} << c;
+    return mask;
+}
+
+/// Columns of the first two fields of `component` in `table`, which must have it
+auto xy_columns(Table& table, uint32_t component) noexcept -> std::pair<float *, float *> {
+    const auto first = table.first_column[*table.find(component)];
+    return {
+        reinterpret_cast<float *>(table.columns[first].data.get()),
+        reinterpret_cast<float *>(table.columns[first + 1].data.get()),
+    };
+}
+
+/// Releases column block shared with an ArrayBuffer. QuickJS calls this on detach and again from the finalizer
+/// with null data, so only the first call owns the holder
+auto release_column(JSRuntime *, void *opaque, void *ptr) -> void {
+    if (ptr != nullptr) delete static_cast<std::shared_ptr<std::byte[]> *>(opaque);
+}
+
+} // namespace
+
+auto JSWorld::component(JSContext *ctx, std::string name, Value layout) noexcept -> JSValue try {
+    if (!JS_IsObject(layout.cget())) return JS_ThrowTypeError(ctx, "Component layout must be an object");
+
+    JSPropertyEnum *props = nullptr;
+    uint32_t length = 0;
+    if (JS_GetOwnPropertyNames(ctx, &props, &length, layout.cget(), JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) < 0) {
+        return JS_EXCEPTION;
+    }
+    defer(JS_FreePropertyEnum(ctx, props, length));
+
+    auto c = Component {.name = std::move(name)};
+    for (uint32_t i = 0; i < length; i++) {
+        auto key = JS_AtomToCString(ctx, props[i].atom);
+        if (key == nullptr) return JS_EXCEPTION;
+        defer(JS_FreeCString(ctx, key));
+
+        auto type_name = convert_from_js<std::string>(own(ctx, JS_GetProperty(ctx, layout.cget(), props[i].atom)));
+        if (!type_name) return jsthrow(type_name.error());
+        const auto type = field_type_from_name(*type_name);
+        if (!type) {
+            return JS_ThrowTypeError(ctx, "Field '%s' has unknown type '%s'", key, type_name->c_str());
+        }
+        c.fields.push_back(Field {.name = key, .type = *type});
+    }
+
+    auto id = define_component(_storage, std::move(c));
+    if (!id) return JS_ThrowRangeError(ctx, "%s", id.error()->msg().c_str());
+    return JS_NewUint32(ctx, *id);
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+auto JSWorld::create(JSContext *ctx, std::optional<std::vector<uint32_t>> components) noexcept -> JSValue try {
+    auto entity = ecs::create(_storage);
+    if (!entity) return JS_ThrowRangeError(ctx, "%s", entity.error()->msg().c_str());
+    for (const auto c : components.value_or(std::vector<uint32_t> {})) {
+        if (auto r = ecs::add(_storage, *entity, c); !r) {
+            (void)ecs::destroy(_storage, *entity);
+            sync_views(ctx);
+            return JS_ThrowRangeError(ctx, "%s", r.error()->msg().c_str());
+        }
+    }
+    sync_views(ctx);
+    return JS_NewUint32(ctx, *entity);
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+auto JSWorld::destroy(JSContext *ctx, JSValueConst this_val, uint32_t entity) noexcept -> JSValue try {
+    if (auto r = ecs::destroy(_storage, entity); !r) return JS_ThrowRangeError(ctx, "%s", r.error()->msg().c_str());
+    sync_views(ctx);
+    return JS_DupValue(ctx, this_val);
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+auto JSWorld::add(
+    JSContext *ctx,
+    JSValueConst this_val,
+    uint32_t entity,
+    uint32_t component,
+    std::optional<Value> values
+) noexcept -> JSValue try {
+    if (auto r = ecs::add(_storage, entity, component); !r) {
+        return JS_ThrowRangeError(ctx, "%s", r.error()->msg().c_str());
+    }
+    sync_views(ctx);
+    if (values) {
+        if (auto r = write(ctx, entity, component, *values); !r) return jsthrow(r.error());
+    }
+    return JS_DupValue(ctx, this_val);
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+auto JSWorld::remove(JSContext *ctx, JSValueConst this_val, uint32_t entity, uint32_t component) noexcept
+    -> JSValue try {
+    if (auto r = ecs::remove(_storage, entity, component); !r) {
+        return JS_ThrowRangeError(ctx, "%s", r.error()->msg().c_str());
+    }
+    sync_views(ctx);
+    return JS_DupValue(ctx, this_val);
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+auto JSWorld::get(JSContext *ctx, uint32_t entity, uint32_t component) noexcept -> JSValue {
+    if (!ecs::has(_storage, entity, component)) {
+        return JS_ThrowRangeError(ctx, "Entity %u does not have component %u", entity, component);
+    }
+    auto obj = JS_NewObject(ctx);
+    const auto& fields = _storage.components[component].fields;
+    for (size_t f = 0; f < fields.size(); f++) {
+        const auto value = read_value(field(_storage, entity, component, f), fields[f].type);
+        JS_SetPropertyStr(ctx, obj, fields[f].name.c_str(), JS_NewFloat64(ctx, value));
+    }
+    return obj;
+}
+
+auto JSWorld::set(JSContext *ctx, JSValueConst this_val, uint32_t entity, uint32_t component, Value values) noexcept
+    -> JSValue {
+    if (auto r = write(ctx, entity, component, values); !r) return jsthrow(r.error());
+    return JS_DupValue(ctx, this_val);
+}
+
+auto JSWorld::write(JSContext *ctx, uint32_t entity, uint32_t component, const Value& values) noexcept
+    -> JSResult<> {
+    if (!ecs::has(_storage, entity, component)) {
+        return JSError::range_error(ctx, fmt::format("Entity {} does not have component {}", entity, component));
+    }
+    const auto& fields = _storage.components[component].fields;
+    for (size_t f = 0; f < fields.size(); f++) {
+        auto value = own(ctx, JS_GetPropertyStr(ctx, values.cget(), fields[f].name.c_str()));
+        if (JS_IsException(value.cget())) return JSError(Value::owned(ctx, JS_GetException(ctx)));
+        if (JS_IsUndefined(value.cget())) continue;
+        auto number = convert_from_js<double>(value);
+        if (!number) return number.error();
+        write_value(field(_storage, entity, component, f), fields[f].type, *number);
+    }
+    return {};
+}
+
+auto JSWorld::query(JSContext *ctx, JSValueConst this_val, std::vector<uint32_t> components) noexcept -> JSValue try {
+    for (const auto c : components) {
+        if (c >= _storage.components.size()) return JS_ThrowRangeError(ctx, "Unknown component %u", c);
+    }
+    const auto mask = mask_of(components);
+    auto world = JS_DupValue(ctx, this_val);
+    auto obj = JSQuery::create_instance(ctx, world, std::move(components), mask);
+    if (JS_IsUndefined(obj)) {
+        JS_FreeValue(ctx, world);
+        return JS_EXCEPTION;
+    }
+    return obj;
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+auto JSWorld::require_vector(JSContext *ctx, uint32_t component) const noexcept -> JSResult<> {
+    if (component >= _storage.components.size()) {
+        return JSError::range_error(ctx, fmt::format("Unknown component {}", component));
+    }
+    const auto& c = _storage.components[component];
+    if (c.fields.size() < 2 || c.fields[0].type != FieldType::f32 || c.fields[1].type != FieldType::f32) {
+        return JSError::type_error(ctx, fmt::format("Component '{}' must start with two f32 fields", c.name));
+    }
+    return {};
+}
+
+auto JSWorld::move(JSContext *ctx, JSValueConst this_val, uint32_t position, uint32_t velocity, std::optional<float> dt)
+    noexcept -> JSValue try {
+    if (auto r = require_vector(ctx, position); !r) return jsthrow(r.error());
+    if (auto r = require_vector(ctx, velocity); !r) return jsthrow(r.error());
+    if (!dt) {
+        auto w = Engine::get(ctx).game_window();
+        dt = w != nullptr ? window::frame_time(*w) : GetFrameTime();
+    }
+
+    const auto step = *dt;
+    for (const auto t : matching(_storage, mask_of(std::array {position, velocity}))) {
+        auto& table = _storage.tables[t];
+        const auto [x, y] = xy_columns(table, position);
+        const auto [vx, vy] = xy_columns(table, velocity);
+        const auto n = table.size();
+        for (size_t i = 0; i < n; i++) x[i] += vx[i] * step;
+        for (size_t i = 0; i < n; i++) y[i] += vy[i] * step;
+    }
+    return JS_DupValue(ctx, this_val);
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+auto JSWorld::draw_rectangles(JSContext *ctx, JSValueConst this_val, uint32_t position, uint32_t size, Color color)
+    noexcept -> JSValue try {
+    if (auto r = require_vector(ctx, position); !r) return jsthrow(r.error());
+    if (auto r = require_vector(ctx, size); !r) return jsthrow(r.error());
+    // Sprites recorded so far were issued before the rectangles
+    core::flush(core::sprite_batch(), Engine::get(ctx).texture_store());
+
+    const auto drawing = IsWindowReady();
+    for (const auto t : matching(_storage, mask_of(std::array {position, size}))) {
+        auto& table = _storage.tables[t];
+        const auto [x, y] = xy_columns(table, position);
+        const auto [w, h] = xy_columns(table, size);
+        for (size_t i = 0; i < table.size(); i++) {
+            const auto rec = Rectangle {.x = x[i], .y = y[i], .width = w[i], .height = h[i]};
+            if (core::visible(core::culling(), rec) && drawing) DrawRectangleRec(rec, color);
+        }
+    }
+    return JS_DupValue(ctx, this_val);
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+auto JSWorld::view(JSContext *ctx, const Column& column, size_t rows) noexcept -> JSValue {
+    // ArrayBuffer shares ownership of the column block, released when JS frees or detaches the buffer.
+    // A column never grown has no block to keep alive
+    auto holder = column.data ? new (std::nothrow) std::shared_ptr<std::byte[]>(column.data) : nullptr;
+    if (column.data && holder == nullptr) return JS_ThrowOutOfMemory(ctx);
+    auto buffer = JS_NewArrayBuffer(
+        ctx,
+        reinterpret_cast<uint8_t *>(column.data.get()),
+        rows * field_size(column.type),
+        holder == nullptr ? nullptr : &release_column,
+        holder,
+        false
+    );
+    if (JS_IsException(buffer)) {
+        delete holder;
+        return buffer;
+    }
+
+    auto args = std::array<JSValue, 3> {buffer, JS_NewInt32(ctx, 0), JS_NewInt64(ctx, int64_t(rows))};
+    auto array = JS_NewTypedArray(ctx, int(args.size()), args.data(), typed_array_type(column.type));
+    if (JS_IsException(array)) {
+        JS_FreeValue(ctx, buffer);
+        return array;
+    }
+    _views.push_back(buffer);
+    return array;
+}
+
+auto JSWorld::sync_views(JSContext *ctx) noexcept -> void {
+    if (_storage.version == _views_version) return;
+    for (auto v : _views) {
+        JS_DetachArrayBuffer(ctx, v);
+        JS_FreeValue(ctx, v);
+    }
+    _views.clear();
+    _views_version = _storage.version;
+}
+
+auto JSQuery::get_chunks(JSContext *ctx) noexcept -> JSValue {
+    auto world = JSWorld::get_instance(borrow(ctx, _world));
+    if (!world) return jsthrow(world.error());
+    if (_version != (*world)->storage().version) {
+        auto chunks = rebuild(ctx, **world);
+        if (JS_IsException(chunks)) return chunks;
+        JS_FreeValue(ctx, _chunks);
+        _chunks = chunks;
+        _version = (*world)->storage().version;
+    }
+    return JS_DupValue(ctx, _chunks);
+}
+
+auto JSQuery::get_count(JSContext *ctx) const noexcept -> int {
+    auto world = JSWorld::get_instance(borrow(ctx, _world));
+    if (!world) return 0;
+    auto& storage = (*world)->storage();
+    auto count = size_t {};
+    for (const auto t : matching(storage, _mask)) count += storage.tables[t].size();
+    return int(count);
+}
+
+auto JSQuery::rebuild(JSContext *ctx, JSWorld& world) noexcept -> JSValue try {
+    auto& storage = world.storage();
+    auto chunks = own(ctx, JS_NewArray(ctx));
+    auto index = uint32_t {};
+    for (const auto t : matching(storage, _mask)) {
+        auto& table = storage.tables[t];
+        if (table.size() == 0) continue;
+
+        auto chunk = own(ctx, JS_NewObject(ctx));
+        JS_SetPropertyStr(ctx, chunk.cget(), "count", JS_NewInt64(ctx, int64_t(table.size())));
+        // Entity list is small next to columns, and copying it keeps entity vector free to grow
+        auto entities = JS_NewArrayBufferCopy(
+            ctx,
+            reinterpret_cast<const uint8_t *>(table.entities.data()),
+            table.size() * sizeof(Entity)
+        );
+        if (JS_IsException(entities)) return entities;
+        auto entities_array = JS_NewTypedArray(ctx, 1, &entities, JS_TYPED_ARRAY_UINT32);
+        JS_FreeValue(ctx, entities);
+        if (JS_IsException(entities_array)) return entities_array;
+        JS_SetPropertyStr(ctx, chunk.cget(), "entities", entities_array);
+
+        auto columns = JS_NewArray(ctx);
+        JS_SetPropertyStr(ctx, chunk.cget(), "columns", columns);
+        for (uint32_t i = 0; i < _components.size(); i++) {
+            const auto id = _components[i];
+            const auto& component = storage.components[id];
+            const auto first = table.first_column[*table.find(id)];
+            auto fields = JS_NewObject(ctx);
+            for (size_t f = 0; f < component.fields.size(); f++) {
+                auto array = world.view(ctx, table.columns[first + f], table.size());
+                if (JS_IsException(array)) {
+                    JS_FreeValue(ctx, fields);
+                    return array;
+                }
+                JS_SetPropertyStr(ctx, fields, component.fields[f].name.c_str(), array);
+            }
+            JS_SetPropertyStr(ctx, chunk.cget(), component.name.c_str(), JS_DupValue(ctx, fields));
+            JS_SetPropertyUint32(ctx, columns, i, fields);
+        }
+        JS_SetPropertyUint32(ctx, chunks.cget(), index++, chunk.take());
+    }
+    return chunks.take();
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+} // namespace glint::plugins::ecs
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <engine.hpp>
+#include <plugins/core/color.hpp>
+#include <plugins/ecs/storage.hpp>
+#include <quickjs.hpp>
+
+namespace glint::plugins::ecs {
+
+using namespace js;
+
+/// Entities with components of fixed numeric layout. Components are stored by archetype, one contiguous
+/// column per field, and queries hand the columns to JS as typed arrays
+class JSWorld: public JSClass<JSWorld> {
+  public:
+    [[nodiscard]] auto get_count() const noexcept -> int { return int(_storage.count); }
+
+    /// Defines component `name` with fields of `layout`, `{ field: "f32" | "i32" | ... }`. Returns its id
+    auto component(JSContext *ctx, std::string name, Value layout) noexcept -> JSValue;
+
+    /// Creates entity with zeroed `components`
+    auto create(JSContext *ctx, std::optional<std::vector<uint32_t>> components) noexcept -> JSValue;
+
+    auto destroy(JSContext *ctx, JSValueConst this_val, uint32_t entity) noexcept -> JSValue;
+
+    [[nodiscard]] auto alive(uint32_t entity) const noexcept -> bool { return is_alive(_storage, entity); }
+
+    [[nodiscard]] auto has(uint32_t entity, uint32_t component) const noexcept -> bool {
+        return ecs::has(_storage, entity, component);
+    }
+
+    /// Adds `component` to `entity`, setting fields present in `values`
+    auto add(JSContext *ctx, JSValueConst this_val, uint32_t entity, uint32_t component, std::optional<Value> values)
+        noexcept -> JSValue;
+
+    auto remove(JSContext *ctx, JSValueConst this_val, uint32_t entity, uint32_t component) noexcept -> JSValue;
+
+    /// Copy of `component` of `entity` as a plain object
+    auto get(JSContext *ctx, uint32_t entity, uint32_t component) noexcept -> JSValue;
+
+    /// Sets fields of `component` of `entity` present in `values`
+    auto set(JSContext *ctx, JSValueConst this_val, uint32_t entity, uint32_t component, Value values) noexcept
+        -> JSValue;
+
+    /// Query over entities having every one of `components`
+    auto query(JSContext *ctx, JSValueConst this_val, std::vector<uint32_t> components) noexcept -> JSValue;
+
+    /// Native movement system: adds `velocity` times `dt` to `position` of every entity having both.
+    /// Both components must start with `f32` x and y fields
+    auto move(JSContext *ctx, JSValueConst this_val, uint32_t position, uint32_t velocity, std::optional<float> dt)
+        noexcept -> JSValue;
+
+    /// Native rendering system: draws a culled rectangle for every entity having `position` and `size`.
+    /// Both components must start with two `f32` fields
+    auto draw_rectangles(JSContext *ctx, JSValueConst this_val, uint32_t position, uint32_t size, Color color)
+        noexcept -> JSValue;
+
+    [[nodiscard]] auto storage() noexcept -> Storage& { return _storage; }
+
+    /// Typed array over first `rows` values of `column`, detached on the next structural change of the world
+    auto view(JSContext *ctx, const Column& column, size_t rows) noexcept -> JSValue;
+
+    [[nodiscard]] auto to_string() const noexcept -> std::string {
+        return fmt::format("World({} entities, {} components)", _storage.count, _storage.components.size());
+    }
+
+  private:
+    Storage _storage {};
+    /// Owned ArrayBuffers of typed arrays handed out since `_views_version`
+    std::vector<JSValue> _views {};
+    uint64_t _views_version = 0;
+
+    /// Detaches typed arrays handed out before a structural change, so JS never sees moved rows
+    auto sync_views(JSContext *ctx) noexcept -> void;
+
+    auto write(JSContext *ctx, uint32_t entity, uint32_t component, const Value& values) noexcept -> JSResult<>;
+
+    /// Checks that `component` starts with two `f32` fields
+    auto require_vector(JSContext *ctx, uint32_t component) const noexcept -> JSResult<>;
+
+  public: // JSClass implementation
+    constexpr static auto class_name = "World";
+
+    inline static auto static_properties = PropertyList {};
+
+    inline static auto instance_properties = PropertyList {
+        export_get_only<&JSWorld::get_count>("count"),
+        export_method<&JSWorld::component>("component"),
+        export_method<&JSWorld::create>("create"),
+        export_method<&JSWorld::destroy>("destroy"),
+        export_method<&JSWorld::alive>("alive"),
+        export_method<&JSWorld::has>("has"),
+        export_method<&JSWorld::add>("add"),
+        export_method<&JSWorld::remove>("remove"),
+        export_method<&JSWorld::get>("get"),
+        export_method<&JSWorld::set>("set"),
+        export_method<&JSWorld::query>("query"),
+        export_method<&JSWorld::move>("move"),
+        export_method<&JSWorld::draw_rectangles>("drawRectangles"),
+        export_method<&JSWorld::to_string>("toString"),
+    };
+
+    auto initialize() noexcept -> void {}
+
+    constexpr static JSClassFinalizer *class_finalizer = [](JSRuntime *rt, JSValueConst val) noexcept -> void {
+        auto ptr = static_cast<JSWorld *>(JS_GetOpaque(val, JSWorld::class_id(rt)));
+        if (ptr == nullptr) return;
+        // Typed arrays still alive keep their column blocks through shared ownership
+        for (auto v : ptr->_views) JS_FreeValueRT(rt, v);
+        deallocate(ptr);
+    };
+
+    constexpr static JSClassGCMark *class_gc_mark = [](JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark) {
+        auto ptr = static_cast<JSWorld *>(JS_GetOpaque(val, JSWorld::class_id(rt)));
+        if (ptr == nullptr) return;
+        for (auto v : ptr->_views) JS_MarkValue(rt, v, mark);
+    };
+};
+
+/// Entities having a set of components. Chunks are rebuilt only after the world changed structurally,
+/// so iterating a query every frame allocates nothing while entities stay put
+class JSQuery: public JSClass<JSQuery> {
+  public:
+    /// One chunk per matching archetype: `{ count, entities, columns, [component name]: columns[i] }`
+    auto get_chunks(JSContext *ctx) noexcept -> JSValue;
+
+    /// Entities matching the query
+    [[nodiscard]] auto get_count(JSContext *ctx) const noexcept -> int;
+
+    [[nodiscard]] auto to_string() const noexcept -> std::string {
+        return fmt::format("Query({} components)", _components.size());
+    }
+
+  private:
+    /// Owned World
+    JSValue _world = JS_UNDEFINED;
+    std::vector<uint32_t> _components {};
+    uint64_t _mask = 0;
+    /// Owned array of chunks, built at `_version` of the world
+    JSValue _chunks = JS_UNDEFINED;
+    std::optional<uint64_t> _version {};
+
+    auto rebuild(JSContext *ctx, JSWorld& world) noexcept -> JSValue;
+
+  public: // JSClass implementation
+    constexpr static auto class_name = "Query";
+
+    inline static auto static_properties = PropertyList {};
+
+    inline static auto instance_properties = PropertyList {
+        export_get_only<&JSQuery::get_chunks>("chunks"),
+        export_get_only<&JSQuery::get_count>("count"),
+        export_method<&JSQuery::to_string>("toString"),
+    };
+
+    /// Takes ownership of `world`
+    auto initialize(JSValue world, std::vector<uint32_t> components, uint64_t mask) noexcept -> void {
+        _world = world;
+        _components = std::move(components);
+        _mask = mask;
+    }
+
+    constexpr static JSCFunction *constructor = [](JSContext *ctx, JSValueConst, int, JSValueConst *) -> JSValue {
+        return JS_ThrowTypeError(ctx, "Queries are created by World.query");
+    };
+
+    constexpr static JSClassFinalizer *class_finalizer = [](JSRuntime *rt, JSValueConst val) noexcept -> void {
+        auto ptr = static_cast<JSQuery *>(JS_GetOpaque(val, JSQuery::class_id(rt)));
+        if (ptr == nullptr) return;
+        JS_FreeValueRT(rt, ptr->_world);
+        JS_FreeValueRT(rt, ptr->_chunks);
+        deallocate(ptr);
+    };
+
+    constexpr static JSClassGCMark *class_gc_mark = [](JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark) {
+        auto ptr = static_cast<JSQuery *>(JS_GetOpaque(val, JSQuery::class_id(rt)));
+        if (ptr == nullptr) return;
+        JS_MarkValue(rt, ptr->_world, mark);
+        JS_MarkValue(rt, ptr->_chunks, mark);
+    };
+};
+
+inline auto world_module(JSContext *ctx) -> JSModuleDef * {
+    auto m = JS_NewCModule(ctx, "@glint/ecs/World", [](auto ctx, auto m) -> int {
+        // Query prototype must exist before the first World.query
+        JSQuery::define(ctx);
+        auto ctor = JSWorld::define(ctx).take();
+        JS_SetModuleExport(ctx, m, "World", JS_DupValue(ctx, ctor));
+        JS_SetModuleExport(ctx, m, "default", ctor);
+        return 0;
+    });
+
+    JS_AddModuleExport(ctx, m, "World");
+    JS_AddModuleExport(ctx, m, "default");
+    return m;
+}
+
+} // namespace glint::plugins::ecs
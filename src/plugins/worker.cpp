@@ -0,0 +1,2 @@
+#include "worker/thread.cpp"
+#include "worker/worker.cpp"
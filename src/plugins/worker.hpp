@@ -0,0 +1,39 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <plugins/worker/worker.hpp>
+
+namespace glint::plugins::worker {
+
+constexpr static char WORKER_MODULE[] = {
+#include "worker_module.js.h"
+};
+
+auto plugin(JSContext *ctx) -> EnginePlugin {
+    // SharedArrayBuffers created by game must be shareable with worker runtimes
+    JS_SetSharedArrayBufferFunctions(JS_GetRuntime(ctx), shared_array_buffer_functions());
+    // Blocking in `Atomics.wait` would stall the frame, so only workers may do it
+    JS_SetCanBlock(JS_GetRuntime(ctx), false);
+
+    return EnginePlugin {
+        .name = "worker",
+        .c_modules =
+            {
+                {"@glint/worker/Worker", worker_module(ctx)},
+            },
+        .js_modules =
+            {
+                {"@glint/worker", WORKER_MODULE},
+            },
+        .unload = [=]() -> Result<> {
+            shutdown_workers(ctx);
+            return {};
+        },
+        .update = [=]() -> Result<> {
+            return dispatch_workers(ctx);
+        },
+    };
+}
+
+} // namespace glint::plugins::worker
@@ -0,0 +1,328 @@
+#include <plugins/worker/thread.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+
+#include <defer.hpp>
+#include <engine/modules.hpp>
+#include <plugins/core/console.hpp>
+
+namespace glint::plugins::worker {
+
+namespace {
+
+/// Reference count placed right before the memory of a SharedArrayBuffer
+struct alignas(std::max_align_t) SharedHeader {
+    std::atomic<int> refs;
+};
+
+auto header_of(void *ptr) noexcept -> SharedHeader * {
+    return reinterpret_cast<SharedHeader *>(static_cast<std::byte *>(ptr) - sizeof(SharedHeader));
+}
+
+auto shared_alloc(void *, size_t size) noexcept -> void * {
+    auto block = static_cast<std::byte *>(std::calloc(1, sizeof(SharedHeader) + size));
+    if (block == nullptr) return nullptr;
+    new (block) SharedHeader {.refs = 1};
+    return block + sizeof(SharedHeader);
+}
+
+auto shared_free(void *, void *ptr) noexcept -> void {
+    auto header = header_of(ptr);
+    if (header->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    header->~SharedHeader();
+    std::free(header);
+}
+
+auto shared_dup(void *, void *ptr) noexcept -> void {
+    header_of(ptr)->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+constexpr auto shared_functions = JSSharedArrayBufferFunctions {
+    .sab_alloc = shared_alloc,
+    .sab_free = shared_free,
+    .sab_dup = shared_dup,
+    .sab_opaque = nullptr,
+};
+
+auto thread_of(JSContext *ctx) noexcept -> Thread& {
+    return *static_cast<Thread *>(JS_GetRuntimeOpaque(JS_GetRuntime(ctx)));
+}
+
+auto push_event(Thread& self, Event event) -> void {
+    auto lock = std::lock_guard(self.mutex);
+    self.outbox.push_back(std::move(event));
+}
+
+/// Sends pending exception of `ctx` to main thread, unless it was raised to stop the worker
+auto report(Thread& self, JSContext *ctx) -> void {
+    auto e = JSError(own(ctx, JS_GetException(ctx)));
+    if (self.stopping) return;
+    push_event(self, Event {.error = e.msg()});
+}
+
+auto run_jobs(Thread& self, JSRuntime *rt) -> void {
+    for (;;) {
+        auto ctx = static_cast<JSContext *>(nullptr);
+        const auto r = JS_ExecutePendingJob(rt, &ctx);
+        if (r == 0) return;
+        if (r < 0) report(self, ctx);
+    }
+}
+
+auto interrupt(JSRuntime *, void *opaque) noexcept -> int {
+    return static_cast<Thread *>(opaque)->stopping.load(std::memory_order_relaxed) ? 1 : 0;
+}
+
+/// Names game modules the way main thread does, so that `./a` and `./a.js` are one module and match packed bytecode
+auto normalize_module(JSContext *ctx, const char *base_name, const char *module_name, void *) noexcept -> char * try {
+    const auto name = std::string_view(module_name);
+    if (name.starts_with("@glint/")) return js_strdup(ctx, module_name);
+    return js_strdup(ctx, engine::modules::normalize(engine::modules::resolve(base_name, name)).c_str());
+} catch (std::exception& e) {
+    JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+    return nullptr;
+}
+
+/// Loads game modules from file store. Engine modules are bound to the main thread context, so workers have none
+auto load_module(JSContext *ctx, const char *module_name, void *opaque) noexcept -> JSModuleDef * try {
+    auto& self = *static_cast<Thread *>(opaque);
+    const auto name = std::string(module_name);
+    if (name.starts_with("@glint/")) {
+        JS_ThrowReferenceError(ctx, "Module %s is not available in workers", module_name);
+        return nullptr;
+    }
+
+    auto mod = engine::bytecode::compile_file(ctx, *self.store, self.cache, name, name);
+    if (!mod) {
+        JS_ThrowPlainError(ctx, "%s", mod.error()->msg().c_str());
+        return nullptr;
+    }
+    if (JS_IsException(*mod)) return nullptr;
+    auto m = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(*mod));
+    JS_FreeValue(ctx, *mod);
+    return m;
+} catch (std::exception& e) {
+    JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+    return nullptr;
+}
+
+auto post_message(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) noexcept -> JSValue try {
+    auto args = unpack_args<Value, std::optional<std::vector<Value>>>(ctx, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto& [value, transfer] = *args;
+    auto message = Message::write(ctx, value.cget(), transfer.value_or(std::vector<Value> {}));
+    if (!message) return jsthrow(message.error());
+    push_event(thread_of(ctx), Event {.message = std::move(*message)});
+    return JS_UNDEFINED;
+} catch (std::exception& e) {
+    return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+}
+
+auto close_self(JSContext *ctx, JSValueConst, int, JSValueConst *) noexcept -> JSValue {
+    thread_of(ctx).closing = true;
+    return JS_UNDEFINED;
+}
+
+/// Worker global scope: `self`, `postMessage`, `close` and `console`. The handler is read from `onmessage`
+auto install_globals(JSContext *ctx) -> void {
+    auto global = JS_GetGlobalObject(ctx);
+    defer(JS_FreeValue(ctx, global));
+    JS_SetPropertyStr(ctx, global, "self", JS_DupValue(ctx, global));
+    JS_SetPropertyStr(ctx, global, "postMessage", JS_NewCFunction(ctx, post_message, "postMessage", 2));
+    JS_SetPropertyStr(ctx, global, "close", JS_NewCFunction(ctx, close_self, "close", 0));
+
+    auto console = JS_NewObject(ctx);
+    JS_SetPropertyFunctionList(ctx, console, core::FUNCS.data(), int(core::FUNCS.size()));
+    JS_SetPropertyStr(ctx, global, "console", console);
+}
+
+/// Evaluates entry module and its top-level await. Returns false when it threw
+auto evaluate(Thread& self, JSContext *ctx) -> bool {
+    auto mod = engine::bytecode::compile_file(ctx, *self.store, self.cache, self.entry, self.entry.generic_string());
+    if (!mod) {
+        push_event(self, Event {.error = mod.error()->msg()});
+        return false;
+    }
+    if (JS_IsException(*mod)) {
+        report(self, ctx);
+        return false;
+    }
+
+    auto ret = JS_EvalFunction(ctx, *mod);
+    defer(JS_FreeValue(ctx, ret));
+    if (JS_IsException(ret)) {
+        report(self, ctx);
+        return false;
+    }
+    run_jobs(self, JS_GetRuntime(ctx));
+    if (JS_PromiseState(ctx, ret) == JS_PROMISE_REJECTED) {
+        JS_Throw(ctx, JS_PromiseResult(ctx, ret));
+        report(self, ctx);
+        return false;
+    }
+    return true;
+}
+
+/// Calls `onmessage` of worker global scope with `{ data }`
+auto deliver(Thread& self, JSContext *ctx, const Message& message) -> void {
+    auto data = message.read(ctx);
+    if (JS_IsException(data)) {
+        report(self, ctx);
+        return;
+    }
+    auto event = JS_NewObject(ctx);
+    defer(JS_FreeValue(ctx, event));
+    JS_SetPropertyStr(ctx, event, "data", data);
+
+    auto global = JS_GetGlobalObject(ctx);
+    defer(JS_FreeValue(ctx, global));
+    auto handler = JS_GetPropertyStr(ctx, global, "onmessage");
+    defer(JS_FreeValue(ctx, handler));
+    if (!JS_IsFunction(ctx, handler)) return;
+
+    auto ret = JS_Call(ctx, handler, global, 1, &event);
+    if (JS_IsException(ret)) report(self, ctx);
+    JS_FreeValue(ctx, ret);
+}
+
+auto run(Thread& self) noexcept -> void try {
+    // Declared first, so that it is set only after the runtime is freed
+    defer(self.finished = true);
+
+    auto rt = JS_NewRuntime();
+    if (rt == nullptr) {
+        push_event(self, Event {.error = "Could not allocate worker runtime"});
+        return;
+    }
+    defer(JS_FreeRuntime(rt));
+    JS_SetRuntimeOpaque(rt, &self);
+    // Unlike main thread, a worker may block in `Atomics.wait`
+    JS_SetCanBlock(rt, true);
+    JS_SetSharedArrayBufferFunctions(rt, shared_array_buffer_functions());
+    JS_SetInterruptHandler(rt, interrupt, &self);
+    JS_SetModuleLoaderFunc(rt, normalize_module, load_module, &self);
+
+    auto ctx = JS_NewContext(rt);
+    if (ctx == nullptr) {
+        push_event(self, Event {.error = "Could not allocate worker context"});
+        return;
+    }
+    defer(JS_FreeContext(ctx));
+    install_globals(ctx);
+
+    SPDLOG_DEBUG("Starting worker {}", self.entry.string());
+    if (!evaluate(self, ctx)) return;
+
+    while (!self.closing) {
+        auto message = Message {};
+        {
+            auto lock = std::unique_lock(self.mutex);
+            self.cv.wait(lock, [&] { return self.stopping || !self.inbox.empty(); });
+            if (self.stopping) return;
+            message = std::move(self.inbox.front());
+            self.inbox.pop_front();
+        }
+        deliver(self, ctx, message);
+        run_jobs(self, rt);
+    }
+    SPDLOG_DEBUG("Worker {} closed itself", self.entry.string());
+} catch (std::exception& e) {
+    SPDLOG_ERROR("Unexpected C++ exception in worker {}: {}", self.entry.string(), e.what());
+}
+
+} // namespace
+
+auto shared_array_buffer_functions() noexcept -> const JSSharedArrayBufferFunctions * {
+    return &shared_functions;
+}
+
+auto Message::write(JSContext *ctx, JSValueConst value, std::span<const Value> transfer) noexcept
+    -> JSResult<Message> try {
+    for (const auto& buffer : transfer) {
+        if (!JS_IsArrayBuffer(buffer.cget())) return JSError::type_error(ctx, "Only ArrayBuffers can be transferred");
+    }
+
+    auto size = size_t {};
+    auto shared = JSSABTab {};
+    auto bytes = JS_WriteObject2(ctx, &size, value, JS_WRITE_OBJ_SAB | JS_WRITE_OBJ_REFERENCE, &shared);
+    if (bytes == nullptr) return JSError(own(ctx, JS_GetException(ctx)));
+    defer(js_free(ctx, bytes));
+    defer(js_free(ctx, shared.tab));
+
+    auto message = Message {};
+    message._bytes.assign(bytes, bytes + size);
+    message._shared.reserve(shared.len);
+    for (size_t i = 0; i < shared.len; i++) {
+        shared_dup(nullptr, shared.tab[i]);
+        message._shared.push_back(shared.tab[i]);
+    }
+
+    // Runtimes do not share heaps, so transferred buffers are copied above and then taken away from sender
+    for (const auto& buffer : transfer) {
+        JS_DetachArrayBuffer(ctx, buffer.cget());
+    }
+    return message;
+} catch (std::exception& e) {
+    return JSError::plain_error(ctx, fmt::format("Unexpected C++ exception: {}", e.what()));
+}
+
+auto Message::read(JSContext *ctx) const noexcept -> JSValue {
+    return JS_ReadObject(ctx, _bytes.data(), _bytes.size(), JS_READ_OBJ_SAB | JS_READ_OBJ_REFERENCE);
+}
+
+Message::Message(Message&& other) noexcept :
+    _bytes(std::move(other._bytes)),
+    _shared(std::exchange(other._shared, {})) {}
+
+auto Message::operator=(Message&& other) noexcept -> Message& {
+    std::swap(_bytes, other._bytes);
+    std::swap(_shared, other._shared);
+    return *this;
+}
+
+Message::~Message() {
+    for (auto ptr : _shared) {
+        shared_free(nullptr, ptr);
+    }
+}
+
+Thread::~Thread() {
+    terminate(*this);
+    join(*this);
+}
+
+auto start(Thread& self) -> void {
+    self.thread = std::thread(run, std::ref(self));
+}
+
+auto post(Thread& self, Message message) -> void {
+    {
+        auto lock = std::lock_guard(self.mutex);
+        self.inbox.push_back(std::move(message));
+    }
+    self.cv.notify_one();
+}
+
+auto take_events(Thread& self) -> std::deque<Event> {
+    auto lock = std::lock_guard(self.mutex);
+    return std::exchange(self.outbox, {});
+}
+
+auto terminate(Thread& self) noexcept -> void {
+    {
+        auto lock = std::lock_guard(self.mutex);
+        self.stopping = true;
+        self.inbox.clear();
+    }
+    self.cv.notify_all();
+}
+
+auto join(Thread& self) noexcept -> void {
+    if (self.thread.joinable()) self.thread.join();
+}
+
+} // namespace glint::plugins::worker
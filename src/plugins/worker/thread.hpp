@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <engine/bytecode.hpp>
+#include <file_store.hpp>
+#include <quickjs.hpp>
+
+namespace glint::plugins::worker {
+
+using namespace js;
+
+/// SharedArrayBuffer allocator shared by every runtime, so a buffer outlives the runtime that created it.
+/// Must be installed on a runtime before it creates its first SharedArrayBuffer
+[[nodiscard]] auto shared_array_buffer_functions() noexcept -> const JSSharedArrayBufferFunctions *;
+
+/// Structured clone of a JS value, independent of any runtime. SharedArrayBuffers are shared instead of copied
+class Message {
+  public:
+    Message() noexcept = default;
+
+    /// Serializes `value`, then detaches ArrayBuffers listed in `transfer`
+    static auto write(JSContext *ctx, JSValueConst value, std::span<const Value> transfer) noexcept
+        -> JSResult<Message>;
+
+    /// Deserializes message into `ctx`. Returns exception value on failure
+    [[nodiscard]] auto read(JSContext *ctx) const noexcept -> JSValue;
+
+    Message(const Message&) = delete;
+    Message(Message&& other) noexcept;
+    auto operator=(const Message&) -> Message& = delete;
+    auto operator=(Message&& other) noexcept -> Message&;
+    ~Message();
+
+  private:
+    std::vector<uint8_t> _bytes {};
+    /// SharedArrayBuffer blocks referenced by `_bytes`, each holding one reference
+    std::vector<uint8_t *> _shared {};
+};
+
+/// Message or uncaught error sent from worker thread to main thread
+struct Event {
+    std::optional<Message> message {};
+    std::string error {};
+};
+
+/// Background thread evaluating a module in its own runtime and context
+struct Thread {
+    std::filesystem::path entry {};
+    IFileStore *store = nullptr;
+    const engine::bytecode::Cache *cache = nullptr;
+    std::thread thread {};
+    std::mutex mutex {};
+    std::condition_variable cv {};
+    /// Messages posted by main thread
+    std::deque<Message> inbox {};
+    /// Messages and errors posted by worker
+    std::deque<Event> outbox {};
+    /// Set by main thread to interrupt running script and stop
+    std::atomic<bool> stopping = false;
+    /// Set by worker thread after its runtime is freed
+    std::atomic<bool> finished = false;
+    /// Set by `close()` inside worker to stop after the current message. Used by worker thread only
+    bool closing = false;
+
+    Thread() = default;
+    Thread(const Thread&) = delete;
+    Thread(Thread&&) = delete;
+    auto operator=(const Thread&) -> Thread& = delete;
+    auto operator=(Thread&&) -> Thread& = delete;
+    ~Thread();
+};
+
+/// Starts worker thread evaluating `self.entry`
+auto start(Thread& self) -> void;
+
+/// Queues message for worker. Must be called from main thread
+auto post(Thread& self, Message message) -> void;
+
+/// Takes events posted by worker so far. Must be called from main thread
+auto take_events(Thread& self) -> std::deque<Event>;
+
+/// Asks worker to stop: running script is interrupted and queued messages are dropped
+auto terminate(Thread& self) noexcept -> void;
+
+/// Waits for worker thread to stop. `Atomics.wait` without timeout in worker delays this until it returns
+auto join(Thread& self) noexcept -> void;
+
+} // namespace glint::plugins::worker
@@ -0,0 +1,163 @@
+#include <plugins/worker/worker.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include <engine/modules.hpp>
+
+namespace glint::plugins::worker {
+
+namespace {
+
+/// Calls `handler` with event object `{ [key]: value }`, taking ownership of `value`
+auto call_handler(JSContext *ctx, JSValueConst this_val, JSValueConst handler, const char *key, JSValue value)
+    -> Result<> {
+    auto event = JS_NewObject(ctx);
+    JS_SetPropertyStr(ctx, event, key, value);
+    // Handler may replace itself while running
+    auto fn = JS_DupValue(ctx, handler);
+    auto ret = JS_Call(ctx, fn, this_val, 1, &event);
+    JS_FreeValue(ctx, fn);
+    JS_FreeValue(ctx, event);
+    if (JS_IsException(ret)) return err(JSError(own(ctx, JS_GetException(ctx))));
+    JS_FreeValue(ctx, ret);
+    return {};
+}
+
+auto unregister(JSContext *ctx, JSValueConst worker) -> void {
+    auto& running = running_workers();
+    const auto it = std::ranges::find_if(running, [&](const RunningWorker& r) {
+        return JS_VALUE_GET_PTR(r.worker) == JS_VALUE_GET_PTR(worker);
+    });
+    if (it == running.end()) return;
+    const auto v = it->worker;
+    running.erase(it);
+    JS_FreeValue(ctx, v);
+}
+
+} // namespace
+
+auto JSWorker::initialize(std::filesystem::path entry, IFileStore *store, const engine::bytecode::Cache *cache) noexcept
+    -> void {
+    _entry = entry;
+    _thread = std::make_unique<Thread>();
+    _thread->entry = std::move(entry);
+    _thread->store = store;
+    _thread->cache = cache;
+}
+
+auto JSWorker::post_message(JSContext *ctx, Value data, std::optional<std::vector<Value>> transfer) noexcept
+    -> JSValue {
+    // Like on the web, messages to a stopped worker are silently dropped
+    if (!_thread) return JS_UNDEFINED;
+    auto message = Message::write(ctx, data.cget(), transfer.value_or(std::vector<Value> {}));
+    if (!message) return jsthrow(message.error());
+    try {
+        post(*_thread, std::move(*message));
+    } catch (std::exception& e) {
+        return JS_ThrowPlainError(ctx, "Unexpected C++ exception: %s", e.what());
+    }
+    return JS_UNDEFINED;
+}
+
+auto JSWorker::terminate(JSContext *ctx, JSValueConst this_val) noexcept -> JSValue {
+    stop(ctx, this_val);
+    return JS_UNDEFINED;
+}
+
+auto JSWorker::stop(JSContext *ctx, JSValueConst this_val) noexcept -> void {
+    if (!_thread) return;
+    SPDLOG_DEBUG("Stopping {}", to_string());
+    worker::terminate(*_thread);
+    retired_threads().push_back(std::move(_thread));
+    unregister(ctx, this_val);
+}
+
+auto JSWorker::dispatch(JSContext *ctx, JSValueConst this_val) noexcept -> Result<> try {
+    if (!_thread) return {};
+    // Read before taking events, so that no event can be posted after the last take
+    const auto finished = _thread->finished.load();
+    for (auto& event : take_events(*_thread)) {
+        // A handler may have terminated the worker
+        if (!_thread) return {};
+        if (event.message) {
+            if (!JS_IsFunction(ctx, _onmessage)) continue;
+            auto data = event.message->read(ctx);
+            if (JS_IsException(data)) return err(JSError(own(ctx, JS_GetException(ctx))));
+            if (auto r = call_handler(ctx, this_val, _onmessage, "data", data); !r) return err(r);
+        } else if (JS_IsFunction(ctx, _onerror)) {
+            auto message = JS_NewStringLen(ctx, event.error.data(), event.error.size());
+            if (auto r = call_handler(ctx, this_val, _onerror, "message", message); !r) return err(r);
+        } else {
+            SPDLOG_ERROR("Uncaught error in {}: {}", to_string(), event.error);
+        }
+    }
+    if (finished) stop(ctx, this_val);
+    return {};
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto JSWorker::custom_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+    -> JSValue {
+    auto args = unpack_args<std::string>(ctx, argc, argv);
+    if (!args) return jsthrow(args.error());
+    // Named like imported modules, so that entry imported back by its dependencies is not loaded twice
+    const auto name = engine::modules::normalize(engine::modules::resolve("", std::get<0>(*args)));
+    const auto entry = std::filesystem::path(name);
+
+    auto& engine = Engine::get(ctx);
+    auto obj = create_instance_this(borrow(ctx, this_val), entry, &engine.file_store(), engine.bytecode_cache());
+    if (JS_IsUndefined(obj)) return JS_EXCEPTION;
+    auto worker = get_instance(borrow(ctx, obj));
+    if (!worker) {
+        JS_FreeValue(ctx, obj);
+        return jsthrow(worker.error());
+    }
+
+    try {
+        start(*(*worker)->_thread);
+        running_workers().push_back({.ctx = ctx, .worker = JS_DupValue(ctx, obj)});
+    } catch (std::exception& e) {
+        JS_FreeValue(ctx, obj);
+        return JS_ThrowPlainError(ctx, "Could not start worker: %s", e.what());
+    }
+    return obj;
+}
+
+auto dispatch_workers(JSContext *ctx) noexcept -> Result<> try {
+    std::erase_if(retired_threads(), [](const auto& t) { return !t->thread.joinable() || t->finished; });
+
+    // Handlers may start or stop workers, so they run over a copy holding its own references
+    auto snapshot = std::vector<Value> {};
+    for (const auto& r : running_workers()) {
+        if (r.ctx == ctx) snapshot.push_back(own(ctx, JS_DupValue(ctx, r.worker)));
+    }
+    for (const auto& v : snapshot) {
+        auto worker = JSWorker::get_instance(v);
+        if (!worker) continue;
+        if (auto r = (*worker)->dispatch(ctx, v.cget()); !r) return err(r);
+    }
+    return {};
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto shutdown_workers(JSContext *ctx) noexcept -> void {
+    // Workers of a game being created next to this one keep running
+    auto stopping = std::vector<JSValue> {};
+    std::erase_if(running_workers(), [&](const RunningWorker& r) {
+        if (r.ctx == ctx) stopping.push_back(r.worker);
+        return r.ctx == ctx;
+    });
+    for (auto v : stopping) {
+        if (auto worker = JSWorker::get_instance(borrow(ctx, v))) (*worker)->stop(ctx, v);
+        JS_FreeValue(ctx, v);
+    }
+    // Destroying a thread waits for it
+    retired_threads().clear();
+}
+
+} // namespace glint::plugins::worker
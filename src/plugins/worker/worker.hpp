@@ -0,0 +1,141 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <engine.hpp>
+#include <plugins/worker/thread.hpp>
+#include <quickjs.hpp>
+
+namespace glint::plugins::worker {
+
+using namespace js;
+
+/// Worker whose thread still runs, with context of the game that started it
+struct RunningWorker {
+    JSContext *ctx = nullptr;
+    /// Owned reference
+    JSValue worker = JS_UNDEFINED;
+};
+
+/// Workers whose threads still run. Holds a reference to each, so handlers are called even when the game
+/// keeps none. A reloaded game is created before the previous one is freed, so both may have workers here
+inline auto running_workers() noexcept -> std::vector<RunningWorker>& {
+    static auto workers = std::vector<RunningWorker> {};
+    return workers;
+}
+
+/// Threads of stopped workers, joined once they finish
+inline auto retired_threads() noexcept -> std::vector<std::unique_ptr<Thread>>& {
+    static auto threads = std::vector<std::unique_ptr<Thread>> {};
+    return threads;
+}
+
+/// Game module evaluated on a background thread, in its own runtime. Values are exchanged as structured clones
+class JSWorker: public JSClass<JSWorker> {
+  public:
+    /// Sends clone of `data` to worker. ArrayBuffers in `transfer` are detached after being cloned
+    auto post_message(JSContext *ctx, Value data, std::optional<std::vector<Value>> transfer) noexcept -> JSValue;
+
+    /// Stops worker, interrupting the script it runs. Messages not yet handled are dropped both ways
+    auto terminate(JSContext *ctx, JSValueConst this_val) noexcept -> JSValue;
+
+    [[nodiscard]] auto get_running() const noexcept -> bool { return _thread != nullptr; }
+
+    [[nodiscard]] auto get_onmessage(JSContext *ctx) const noexcept -> JSValue { return JS_DupValue(ctx, _onmessage); }
+
+    auto set_onmessage(Value handler) noexcept -> void { replace(_onmessage, handler); }
+
+    [[nodiscard]] auto get_onerror(JSContext *ctx) const noexcept -> JSValue { return JS_DupValue(ctx, _onerror); }
+
+    auto set_onerror(Value handler) noexcept -> void { replace(_onerror, handler); }
+
+    /// Calls handlers for events posted by worker since last call. Returns error thrown by a handler
+    auto dispatch(JSContext *ctx, JSValueConst this_val) noexcept -> Result<>;
+
+    [[nodiscard]] auto to_string() const noexcept -> std::string {
+        return fmt::format("Worker({})", _entry.generic_string());
+    }
+
+  private:
+    std::filesystem::path _entry {};
+    /// Null once worker is stopped
+    std::unique_ptr<Thread> _thread {};
+    JSValue _onmessage = JS_NULL;
+    JSValue _onerror = JS_NULL;
+
+    auto replace(JSValue& slot, const Value& handler) noexcept -> void {
+        JS_FreeValue(handler.ctx(), slot);
+        slot = JS_DupValue(handler.ctx(), handler.cget());
+    }
+
+    /// Signals thread to stop and hands it over to `retired_threads`
+    auto stop(JSContext *ctx, JSValueConst this_val) noexcept -> void;
+
+    static auto custom_constructor(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) noexcept
+        -> JSValue;
+
+    friend auto shutdown_workers(JSContext *ctx) noexcept -> void;
+
+  public: // JSClass implementation
+    constexpr static auto class_name = "Worker";
+
+    inline static auto static_properties = PropertyList {};
+
+    inline static auto instance_properties = PropertyList {
+        export_get_only<&JSWorker::get_running>("running"),
+        export_getset<&JSWorker::get_onmessage, &JSWorker::set_onmessage>("onmessage"),
+        export_getset<&JSWorker::get_onerror, &JSWorker::set_onerror>("onerror"),
+        export_method<&JSWorker::post_message>("postMessage"),
+        export_method<&JSWorker::terminate>("terminate"),
+        export_method<&JSWorker::to_string>("toString"),
+    };
+
+    auto initialize(std::filesystem::path entry, IFileStore *store, const engine::bytecode::Cache *cache) noexcept
+        -> void;
+
+    constexpr static JSCFunction *constructor = &custom_constructor;
+
+    constexpr static JSClassFinalizer *class_finalizer = [](JSRuntime *rt, JSValueConst val) noexcept -> void {
+        auto ptr = static_cast<JSWorker *>(JS_GetOpaque(val, JSWorker::class_id(rt)));
+        if (ptr == nullptr) return;
+        if (ptr->_thread) {
+            worker::terminate(*ptr->_thread);
+            retired_threads().push_back(std::move(ptr->_thread));
+        }
+        JS_FreeValueRT(rt, ptr->_onmessage);
+        JS_FreeValueRT(rt, ptr->_onerror);
+        deallocate(ptr);
+    };
+
+    constexpr static JSClassGCMark *class_gc_mark = [](JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark) {
+        auto ptr = static_cast<JSWorker *>(JS_GetOpaque(val, JSWorker::class_id(rt)));
+        if (ptr == nullptr) return;
+        JS_MarkValue(rt, ptr->_onmessage, mark);
+        JS_MarkValue(rt, ptr->_onerror, mark);
+    };
+};
+
+/// Calls handlers of workers started in `ctx` and joins threads of stopped ones. Must be called from main thread
+auto dispatch_workers(JSContext *ctx) noexcept -> Result<>;
+
+/// Stops every worker started in `ctx` and waits for threads of stopped workers
+auto shutdown_workers(JSContext *ctx) noexcept -> void;
+
+inline auto worker_module(JSContext *ctx) -> JSModuleDef * {
+    auto m = JS_NewCModule(ctx, "@glint/worker/Worker", [](auto ctx, auto m) -> int {
+        auto ctor = JSWorker::define(ctx).take();
+        JS_SetModuleExport(ctx, m, "Worker", JS_DupValue(ctx, ctor));
+        JS_SetModuleExport(ctx, m, "default", ctor);
+        return 0;
+    });
+
+    JS_AddModuleExport(ctx, m, "Worker");
+    JS_AddModuleExport(ctx, m, "default");
+    return m;
+}
+
+} // namespace glint::plugins::worker
@@ -0,0 +1 @@
+export * from "@glint/worker/Worker";
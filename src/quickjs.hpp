@@ -2,7 +2,10 @@
 #include <quickjs/convert.hpp>
 #include <quickjs/error.hpp>
 #include <quickjs/function.hpp>
+#include <quickjs/instances.hpp>
 #include <quickjs/object.hpp>
+#include <quickjs/promise.hpp>
+#include <quickjs/slab.hpp>
 #include <quickjs/types.hpp>
 #include <quickjs/utils.hpp>
 #include <quickjs/value.hpp>
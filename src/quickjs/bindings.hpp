@@ -6,6 +6,8 @@
 #include <boost/callable_traits.hpp>
 
 #include <quickjs/convert.hpp>
+#include <quickjs/instances.hpp>
+#include <quickjs/slab.hpp>
 
 namespace glint::js {
 
@@ -238,11 +240,46 @@ using PropertyList = std::vector<JSCFunctionListEntry>;
 /// - initialize
 /// - static_properties
 /// - instance_properties
+/// - pooled (optional)
 template<typename T>
 class JSClass {
   public:
     friend T;
 
+    /// Small value classes set this to allocate instances from a per-thread `Slab` instead of heap
+    constexpr static bool pooled = false;
+
+    static auto allocate() noexcept -> T * {
+        T *ptr = nullptr;
+        if constexpr (T::pooled) {
+            ptr = Slab<T>::local().create();
+        } else {
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
+            ptr = new (std::nothrow) T();
+        }
+        if (ptr != nullptr) stats().add();
+        return ptr;
+    }
+
+    static auto deallocate(T *ptr) noexcept -> void {
+        if (ptr == nullptr) return;
+        stats().remove();
+        if constexpr (T::pooled) {
+            Slab<T>::local().destroy(ptr);
+        } else {
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
+            delete ptr;
+        }
+    }
+
+    /// Live and peak instance counts of this class on current thread
+    static auto stats() noexcept -> InstanceStats& {
+        thread_local auto stats = InstanceStats {.class_name = T::class_name, .pooled = T::pooled};
+        thread_local auto registered = (instance_stats().push_back(&stats), true);
+        (void)registered;
+        return stats;
+    }
+
     constexpr static JSClassFinalizer *class_finalizer = [](JSRuntime *rt, JSValueConst val) noexcept -> void {
         auto ptr = static_cast<T *>(JS_GetOpaque(val, T::class_id(rt)));
         if (ptr == nullptr) {
@@ -251,8 +288,7 @@ class JSClass {
             return;
         }
 
-        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-        delete ptr;
+        T::deallocate(ptr);
     };
 
     constexpr static JSClassGCMark *class_gc_mark = nullptr;
@@ -276,8 +312,7 @@ class JSClass {
             return JS_UNDEFINED;
         }
 
-        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-        auto ptr = new (std::nothrow) T();
+        auto ptr = T::allocate();
         auto init = std::bind_front(&T::initialize, ptr);
         std::apply(init, args);
         JS_SetOpaque(obj, ptr);
@@ -309,8 +344,7 @@ class JSClass {
             return JS_UNDEFINED;
         }
 
-        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): we cannot express ownership of JS object
-        auto ptr = new (std::nothrow) T();
+        auto ptr = T::allocate();
         auto init = std::bind_front(&T::initialize, ptr);
         std::apply(init, args);
         JS_SetOpaque(obj, ptr);
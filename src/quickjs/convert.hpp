@@ -28,6 +28,31 @@ auto unpack_args_t(JSContext *js, int args, JSValueConst *argv) -> JSResult<Tupl
 //  Implementation
 // ----------------
 
+namespace detail {
+    template<typename T>
+    concept js_number = (std::is_integral_v<T> || std::is_floating_point_v<T>) && (!std::is_same_v<T, bool>);
+
+    /// Reads number straight from value tag, returns false if value is not a number.
+    /// Int-tagged values skip conversion through double
+    template<js_number T>
+    inline auto read_number(JSValueConst v, T& out) noexcept -> bool {
+        switch (JS_VALUE_GET_NORM_TAG(v)) {
+            case JS_TAG_INT:
+                out = static_cast<T>(JS_VALUE_GET_INT(v));
+                return true;
+            case JS_TAG_FLOAT64:
+                out = static_cast<T>(JS_VALUE_GET_FLOAT64(v));
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    inline auto not_a_number(const Value& v) noexcept -> JSError {
+        return JSError::type_error(v.ctx(), fmt::format("Value of type '{}' is not a number", display_type(v)));
+    }
+} // namespace detail
+
 template<>
 inline auto convert_from_js<JSValue>(const Value& v) noexcept -> JSResult<JSValue> {
     return v.cget();
@@ -49,13 +74,8 @@ inline auto convert_from_js<bool>(const Value& v) noexcept -> JSResult<bool> {
 
 template<>
 inline auto convert_from_js<double>(const Value& v) noexcept -> JSResult<double> {
-    if (!JS_IsNumber(v.cget())) {
-        return JSError::type_error(v.ctx(), fmt::format("Value of type '{}' is not a number", display_type(v)));
-    }
-
     auto num = double {};
-    JS_ToFloat64(v.ctx(), &num, v.cget());
-
+    if (!detail::read_number(v.cget(), num)) return detail::not_a_number(v);
     return num;
 }
 
@@ -82,12 +102,11 @@ inline auto convert_from_js<Function>(const Value& v) noexcept -> JSResult<Funct
 }
 
 template<typename T>
-    requires(std::is_integral_v<T> || std::is_floating_point_v<T>) && (!std::is_same_v<T, double>)
-    && (!std::is_same_v<T, bool>)
+    requires detail::js_number<T> && (!std::is_same_v<T, double>)
 inline auto convert_from_js(const Value& v) noexcept -> JSResult<T> {
-    auto num = convert_from_js<double>(v);
-    if (!num) return num.error();
-    return static_cast<T>(*num);
+    auto num = T {};
+    if (!detail::read_number(v.cget(), num)) return detail::not_a_number(v);
+    return num;
 }
 
 template<typename T>
@@ -116,6 +135,33 @@ inline auto convert_from_js(const Value& v) noexcept -> JSResult<T> try {
     return js::JSError::plain_error(v.ctx(), fmt::format("Unexpected error: {}", e.what()));
 }
 
+/// Borrows contents of a typed array. Span is valid only while the typed array is alive and not detached
+template<typename T>
+    requires is_span<T>
+inline auto convert_from_js(const Value& v) noexcept -> JSResult<T> {
+    using Element = std::remove_const_t<typename T::element_type>;
+    constexpr auto expected = typed_array_type_v<Element>;
+
+    if (JS_GetTypedArrayType(v.cget()) != expected) {
+        return JSError::type_error(
+            v.ctx(),
+            fmt::format("Value of type '{}' is not a {}", display_type(v), display_typed_array_type(expected))
+        );
+    }
+
+    auto offset = size_t {};
+    auto length = size_t {};
+    auto buffer = own(v.ctx(), JS_GetTypedArrayBuffer(v.ctx(), v.cget(), &offset, &length, nullptr));
+    if (JS_IsException(buffer.cget())) return JSError(own(v.ctx(), JS_GetException(v.ctx())));
+
+    auto size = size_t {};
+    auto data = JS_GetArrayBuffer(v.ctx(), &size, buffer.cget());
+    if (data == nullptr) return JSError::type_error(v.ctx(), "Typed array buffer is detached");
+
+    // NOLINTNEXTLINE: typed array memory is suitably aligned for its element type
+    return T(reinterpret_cast<typename T::element_type *>(data + offset), length / sizeof(Element));
+}
+
 template<typename T>
     requires is_optional<T>
 inline auto convert_from_js(const Value& v) noexcept -> JSResult<T> {
@@ -180,6 +226,18 @@ template<typename Tuple>
 auto unpack_args_t(JSContext *js, int argc, JSValueConst *argv) -> JSResult<Tuple> {
     constexpr size_t N = std::tuple_size<Tuple>();
 
+    // Signatures made of numbers only are read straight into the result without per-argument `JSResult`s.
+    // On mismatch fall through to the generic path, which reports the error
+    if constexpr ([]<size_t... Is>(std::index_sequence<Is...>) {
+                      return (detail::js_number<std::tuple_element_t<Is, Tuple>> && ...);
+                  }(std::make_index_sequence<N> {})) {
+        auto out = Tuple {};
+        const auto ok = [&]<size_t... Is>(std::index_sequence<Is...>) {
+            return (... && (int(Is) < argc && detail::read_number(argv[Is], std::get<Is>(out))));
+        }(std::make_index_sequence<N> {});
+        if (ok) return out;
+    }
+
     auto args_array = std::array<JSValue, N>();
     args_array.fill(JS_UNDEFINED);
     for (int i = 0; i < argc; i++) {
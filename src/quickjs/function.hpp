@@ -1,10 +1,18 @@
 #pragma once
 
+#include <array>
+#include <memory>
+#include <span>
+#include <utility>
+
 #include <quickjs/value.hpp>
 #include <quickjs/error.hpp>
 
 namespace glint::js {
 
+/// Calls with up to this many arguments do not allocate
+constexpr auto inline_args = size_t {8};
+
 class Function {
   private:
     Value _value;
@@ -18,17 +26,34 @@ class Function {
         return Function(std::move(value));
     }
 
-    auto operator()() noexcept -> JSResult<Value> { return this->operator()(JS_UNDEFINED, {}); }
+    [[nodiscard]] auto ctx() const noexcept -> not_null<JSContext *> { return _value.ctx(); }
+
+    auto operator()() noexcept -> JSResult<Value> { return call(JS_UNDEFINED, 0, nullptr); }
+
+    auto operator()(std::span<const Value> args) noexcept -> JSResult<Value> {
+        return this->operator()(JS_UNDEFINED, args);
+    }
 
-    auto operator()(std::span<Value> args) noexcept -> JSResult<Value> { return this->operator()(JS_UNDEFINED, args); }
+    auto operator()(JSValueConst this_value, std::span<const Value> args) noexcept -> JSResult<Value> {
+        if (args.size() <= inline_args) {
+            auto argv = std::array<JSValue, inline_args> {};
+            for (size_t i = 0; i < args.size(); i++) {
+                argv[i] = args[i].cget();
+            }
+            return call(this_value, int(args.size()), argv.data());
+        }
 
-    auto operator()(JSValueConst this_value, std::span<Value> args) noexcept -> JSResult<Value> {
         auto argv = std::make_unique<JSValue[]>(args.size());
         for (size_t i = 0; i < args.size(); i++) {
             argv[i] = args[i].cget();
         }
-        auto val = JS_Call(_value.ctx(), _value.cget(), this_value, int(args.size()), argv.get());
-        if (JS_HasException(_value.ctx())) {
+        return call(this_value, int(args.size()), argv.get());
+    }
+
+    /// Calls with raw arguments, which stay owned by the caller
+    auto call(JSValueConst this_value, int argc, JSValueConst *argv) noexcept -> JSResult<Value> {
+        auto val = JS_Call(_value.ctx(), _value.cget(), this_value, argc, argv);
+        if (JS_IsException(val)) {
             auto ex = Value::owned(_value.ctx(), JS_GetException(_value.ctx()));
             return JSError(std::move(ex));
         }
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <quickjs/types.hpp>
+
+namespace glint::js {
+
+/// Number of native instances of one JSClass alive on current thread
+struct InstanceStats {
+    czstring class_name = nullptr;
+    bool pooled = false;
+    size_t live = 0;
+    size_t peak = 0;
+
+    auto add() noexcept -> void {
+        live++;
+        peak = std::max(peak, live);
+    }
+
+    auto remove() noexcept -> void {
+        if (live > 0) live--;
+    }
+};
+
+/// Stats of every class instantiated on current thread, in order of first instantiation
+inline auto instance_stats() noexcept -> std::vector<InstanceStats *>& {
+    thread_local auto all = std::vector<InstanceStats *> {};
+    return all;
+}
+
+} // namespace glint::js
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+
+#include <quickjs/error.hpp>
+#include <quickjs/value.hpp>
+
+namespace glint::js {
+
+/// Pending promise together with its resolving functions
+class Promise {
+  private:
+    Value _promise;
+    Value _resolve;
+    Value _reject;
+
+  public:
+    static auto create(not_null<JSContext *> ctx) noexcept -> JSResult<Promise> {
+        auto funcs = std::array<JSValue, 2> {};
+        auto promise = JS_NewPromiseCapability(ctx, funcs.data());
+        if (JS_IsException(promise)) return JSError(own(ctx, JS_GetException(ctx)));
+        return Promise(own(ctx, promise), own(ctx, funcs[0]), own(ctx, funcs[1]));
+    }
+
+    /// Promise object to return to JS
+    [[nodiscard]]
+    auto value() const noexcept -> JSValue {
+        return JS_DupValue(_promise.ctx(), _promise.cget());
+    }
+
+    /// Fulfill promise, taking ownership of `value`
+    auto resolve(JSValue value) noexcept -> void { settle(_resolve, value); }
+
+    /// Reject promise, taking ownership of `reason`
+    auto reject(JSValue reason) noexcept -> void { settle(_reject, reason); }
+
+  private:
+    Promise(Value&& promise, Value&& resolve, Value&& reject) noexcept :
+        _promise(std::move(promise)),
+        _resolve(std::move(resolve)),
+        _reject(std::move(reject)) {}
+
+    static auto settle(const Value& func, JSValue value) noexcept -> void {
+        auto ctx = func.ctx();
+        auto ret = JS_Call(ctx, func.cget(), JS_UNDEFINED, 1, &value);
+        JS_FreeValue(ctx, value);
+        JS_FreeValue(ctx, ret);
+    }
+};
+
+} // namespace glint::js
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace glint::js {
+
+/// Free-list allocator handing out slots for `T` from chunks of `chunk_size` objects.
+/// Freed slots are reused but chunks are kept until the allocator is destroyed.
+/// Not thread-safe, use `Slab::local()` to get allocator of current thread
+template<typename T, size_t chunk_size = 256>
+class Slab {
+  private:
+    union Slot {
+        Slot *next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> _chunks {};
+    Slot *_free = nullptr;
+
+  public:
+    static auto local() noexcept -> Slab& {
+        thread_local auto slab = Slab {};
+        return slab;
+    }
+
+    /// Constructs object in a free slot, returns null when out of memory
+    template<typename... Args>
+    auto create(Args&&...args) noexcept -> T * try {
+        if (_free == nullptr) grow();
+        auto slot = _free;
+        _free = slot->next;
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+        return nullptr;
+    }
+
+    auto destroy(T *ptr) noexcept -> void {
+        if (ptr == nullptr) return;
+        ptr->~T();
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): object lives at the start of its slot
+        auto slot = reinterpret_cast<Slot *>(ptr);
+        slot->next = _free;
+        _free = slot;
+    }
+
+  private:
+    auto grow() -> void {
+        auto chunk = std::make_unique_for_overwrite<Slot[]>(chunk_size);
+        for (auto i = size_t {0}; i < chunk_size; i++) {
+            chunk[i].next = i + 1 < chunk_size ? &chunk[i + 1] : _free;
+        }
+        _free = &chunk[0];
+        _chunks.push_back(std::move(chunk));
+    }
+};
+
+} // namespace glint::js
@@ -2,6 +2,7 @@
 
 #include <gsl/gsl>
 #include <optional>
+#include <span>
 #include <string>
 
 namespace glint::js {
@@ -31,4 +32,10 @@ concept is_optional = requires(T a, typename T::value_type v) {
     requires std::is_constructible_v<T, typename T::value_type>;
 };
 
+template<typename T>
+concept is_span = requires {
+    typename T::element_type;
+    requires std::is_same_v<T, std::span<typename T::element_type>>;
+};
+
 } // namespace glint::js
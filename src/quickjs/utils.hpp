@@ -49,6 +49,61 @@ constexpr inline auto display_type(JSValueConst val) -> czstring {
     return display_type(val.tag);
 }
 
+template<typename T>
+struct typed_array_type {};
+
+template<>
+struct typed_array_type<int8_t>: std::integral_constant<JSTypedArrayEnum, JS_TYPED_ARRAY_INT8> {};
+
+template<>
+struct typed_array_type<uint8_t>: std::integral_constant<JSTypedArrayEnum, JS_TYPED_ARRAY_UINT8> {};
+
+template<>
+struct typed_array_type<int16_t>: std::integral_constant<JSTypedArrayEnum, JS_TYPED_ARRAY_INT16> {};
+
+template<>
+struct typed_array_type<uint16_t>: std::integral_constant<JSTypedArrayEnum, JS_TYPED_ARRAY_UINT16> {};
+
+template<>
+struct typed_array_type<int32_t>: std::integral_constant<JSTypedArrayEnum, JS_TYPED_ARRAY_INT32> {};
+
+template<>
+struct typed_array_type<uint32_t>: std::integral_constant<JSTypedArrayEnum, JS_TYPED_ARRAY_UINT32> {};
+
+template<>
+struct typed_array_type<float>: std::integral_constant<JSTypedArrayEnum, JS_TYPED_ARRAY_FLOAT32> {};
+
+template<>
+struct typed_array_type<double>: std::integral_constant<JSTypedArrayEnum, JS_TYPED_ARRAY_FLOAT64> {};
+
+template<typename T>
+constexpr auto typed_array_type_v = typed_array_type<std::remove_const_t<T>>::value;
+
+constexpr inline auto display_typed_array_type(JSTypedArrayEnum type) -> czstring {
+    switch (type) {
+        case JS_TYPED_ARRAY_INT8:
+            return "Int8Array";
+        case JS_TYPED_ARRAY_UINT8:
+            return "Uint8Array";
+        case JS_TYPED_ARRAY_UINT8C:
+            return "Uint8ClampedArray";
+        case JS_TYPED_ARRAY_INT16:
+            return "Int16Array";
+        case JS_TYPED_ARRAY_UINT16:
+            return "Uint16Array";
+        case JS_TYPED_ARRAY_INT32:
+            return "Int32Array";
+        case JS_TYPED_ARRAY_UINT32:
+            return "Uint32Array";
+        case JS_TYPED_ARRAY_FLOAT32:
+            return "Float32Array";
+        case JS_TYPED_ARRAY_FLOAT64:
+            return "Float64Array";
+        default:
+            return "TypedArray";
+    }
+}
+
 template<typename T>
 auto class_id(not_null<JSRuntime *> rt) -> JSClassID {
     static auto id = JSClassID {0};
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <gsl/gsl>
+#include <optional>
 #include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 
 #include <fmt/format.h>
 
@@ -136,11 +139,11 @@ class Image: public ::Image {
         return {::LoadImageAnim(file_name, frames)};
     }
 
-    static auto load_anim_from_memory(czstring file_type, std::span<unsigned char> data, int *frames) -> Image {
+    static auto load_anim_from_memory(czstring file_type, std::span<const unsigned char> data, int *frames) -> Image {
         return {::LoadImageAnimFromMemory(file_type, data.data(), int(data.size()), frames)};
     }
 
-    static auto load_from_memory(czstring file_type, std::span<unsigned char> data) -> Image {
+    static auto load_from_memory(czstring file_type, std::span<const unsigned char> data) -> Image {
         return {::LoadImageFromMemory(file_type, data.data(), int(data.size()))};
     }
 
@@ -148,6 +151,10 @@ class Image: public ::Image {
 
     static auto load_from_screen() -> Image { return {::LoadImageFromScreen()}; }
 
+    static auto gen_color(int width, int height, ::Color color) -> Image {
+        return {::GenImageColor(width, height, color)};
+    }
+
     Image() noexcept : ::Image {} {}
 
     Image(const Image&) = delete;
@@ -181,14 +188,24 @@ class Texture: public ::Texture {
   public:
     static auto load(czstring file_name) noexcept -> Texture { return {::LoadTexture(file_name)}; }
 
-    static auto load_from_image(::Image image) noexcept -> Texture { return {::LoadTextureFromImage(image)}; }
-
-    static auto load_from_memory(czstring extension, std::span<unsigned char> data) noexcept -> Texture {
-        const auto image = ::LoadImageFromMemory(extension, data.data(), int(data.size()));
+    static auto load_from_image(const ::Image& image) noexcept -> Texture {
         if (!::IsImageValid(image)) return {};
-        const auto texture = ::LoadTextureFromImage(image);
-        ::UnloadImage(image);
-        return {texture};
+        // Without a window there is no GPU context: keep only image metadata
+        if (!::IsWindowReady()) {
+            return {::Texture {
+                .id = 0,
+                .width = image.width,
+                .height = image.height,
+                .mipmaps = image.mipmaps,
+                .format = image.format,
+            }};
+        }
+        return {::LoadTextureFromImage(image)};
+    }
+
+    static auto load_from_memory(czstring extension, std::span<const unsigned char> data) noexcept -> Texture {
+        const auto image = Image::load_from_memory(extension, data);
+        return load_from_image(image);
     }
 
     Texture() noexcept : ::Texture {} {}
@@ -222,7 +239,19 @@ class Texture: public ::Texture {
 
 class RenderTexture: public ::RenderTexture {
   public:
-    static auto load(int width, int height) noexcept -> RenderTexture { return {::LoadRenderTexture(width, height)}; }
+    static auto load(int width, int height) noexcept -> RenderTexture {
+        if (!::IsWindowReady()) {
+            const auto texture = ::Texture {
+                .id = 0,
+                .width = width,
+                .height = height,
+                .mipmaps = 1,
+                .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
+            };
+            return {::RenderTexture {.id = 0, .texture = texture, .depth = {}}};
+        }
+        return {::LoadRenderTexture(width, height)};
+    }
 
     RenderTexture() noexcept : ::RenderTexture {} {};
 
@@ -264,9 +293,18 @@ class Font: public ::Font {
         return {::LoadFontFromImage(image, key, first_char)};
     }
 
+    /// Without a window, TTF/OTF fonts keep glyph metrics and atlas size but get no texture
     static auto load_from_memory(
         czstring file_type,
-        std::span<unsigned char> data,
+        std::span<const unsigned char> data,
+        int font_size,
+        std::optional<std::span<int>> codepoints
+    ) noexcept -> Font;
+
+  private:
+    static auto load_from_memory_gpu(
+        czstring file_type,
+        std::span<const unsigned char> data,
         int font_size,
         std::optional<std::span<int>> codepoints
     ) noexcept -> Font {
@@ -284,6 +322,7 @@ class Font: public ::Font {
         }
     }
 
+  public:
     Font() noexcept : ::Font {} {}
 
     Font(const Font&) = delete;
@@ -297,10 +336,20 @@ class Font: public ::Font {
         return *this;
     }
 
-    ~Font() noexcept { ::UnloadFont(*this); }
+    ~Font() noexcept {
+        // `UnloadFont` takes a font without texture for the default one and frees nothing
+        if (texture.id == 0) {
+            if (glyphs != nullptr) ::UnloadFontData(glyphs, glyphCount);
+            ::MemFree(recs);
+        } else {
+            ::UnloadFont(*this);
+        }
+    }
 
     friend inline auto swap(Font& a, Font& b) noexcept -> void;
 
+    friend class FontAtlas;
+
   private:
     Font(::Font font) noexcept : ::Font {font} {}
 
@@ -314,11 +363,119 @@ class Font: public ::Font {
     }
 };
 
+/// TTF/OTF font rasterized to an atlas image on CPU but not uploaded to GPU yet.
+/// Mirrors `LoadFontFromMemory`, split so that rasterization can run off the main thread
+class FontAtlas {
+  public:
+    static auto rasterize(
+        czstring file_type,
+        std::span<const unsigned char> data,
+        int font_size,
+        std::optional<std::span<int>> codepoints
+    ) noexcept -> FontAtlas {
+        const auto type = std::string_view(file_type);
+        if (type != ".ttf" && type != ".TTF" && type != ".otf" && type != ".OTF") return {};
+
+        constexpr auto default_glyph_count = 95;
+        constexpr auto glyph_padding = 4;
+        auto atlas = FontAtlas {};
+        atlas._font.baseSize = font_size;
+        atlas._font.glyphCount = codepoints ? int(codepoints->size()) : default_glyph_count;
+        atlas._font.glyphs = ::LoadFontData(
+            data.data(),
+            int(data.size()),
+            font_size,
+            codepoints ? codepoints->data() : nullptr,
+            atlas._font.glyphCount,
+            FONT_DEFAULT
+        );
+        if (atlas._font.glyphs == nullptr) return {};
+
+        atlas._font.glyphPadding = glyph_padding;
+        atlas._atlas = ::GenImageFontAtlas(
+            atlas._font.glyphs,
+            &atlas._font.recs,
+            atlas._font.glyphCount,
+            font_size,
+            glyph_padding,
+            0
+        );
+        for (auto i = 0; i < atlas._font.glyphCount; i++) {
+            ::UnloadImage(atlas._font.glyphs[i].image);
+            atlas._font.glyphs[i].image = ::ImageFromImage(atlas._atlas, atlas._font.recs[i]);
+        }
+        return atlas;
+    }
+
+    [[nodiscard]] auto valid() const noexcept -> bool { return _font.glyphs != nullptr; }
+
+    /// Uploads atlas to GPU and moves glyph data into returned font. Must run on main thread.
+    /// Without a window there is no GPU context: the font keeps glyph metrics and only the atlas size
+    auto upload() noexcept -> Font {
+        if (!valid()) return {};
+        auto font = _font;
+        if (::IsWindowReady()) {
+            font.texture = ::LoadTextureFromImage(_atlas);
+        } else {
+            font.texture = ::Texture {
+                .id = 0,
+                .width = _atlas.width,
+                .height = _atlas.height,
+                .mipmaps = _atlas.mipmaps,
+                .format = _atlas.format,
+            };
+        }
+        // Ownership of glyph data moved to `font`, atlas image is not needed after upload
+        ::UnloadImage(_atlas);
+        _atlas = {};
+        _font = {};
+        return {font};
+    }
+
+    FontAtlas() noexcept = default;
+
+    FontAtlas(const FontAtlas&) = delete;
+
+    FontAtlas(FontAtlas&& other) noexcept : _font(other._font), _atlas(other._atlas) {
+        other._font = {};
+        other._atlas = {};
+    }
+
+    auto operator=(const FontAtlas&) -> FontAtlas& = delete;
+
+    auto operator=(FontAtlas&& other) noexcept -> FontAtlas& {
+        std::swap(_font, other._font);
+        std::swap(_atlas, other._atlas);
+        return *this;
+    }
+
+    ~FontAtlas() noexcept {
+        ::UnloadImage(_atlas);
+        if (_font.glyphs != nullptr) ::UnloadFontData(_font.glyphs, _font.glyphCount);
+        ::MemFree(_font.recs);
+    }
+
+  private:
+    ::Font _font {};
+    ::Image _atlas {};
+};
+
+inline auto Font::load_from_memory(
+    czstring file_type,
+    std::span<const unsigned char> data,
+    int font_size,
+    std::optional<std::span<int>> codepoints
+) noexcept -> Font {
+    if (::IsWindowReady()) return load_from_memory_gpu(file_type, data, font_size, codepoints);
+    auto atlas = FontAtlas::rasterize(file_type, data, font_size, codepoints);
+    return atlas.upload();
+}
+
 class Wave: public ::Wave {
   public:
     static auto load(czstring file_name) noexcept -> Wave { return {::LoadWave(file_name)}; }
 
-    static auto load_from_memory(czstring file_type, std::span<unsigned char> data) noexcept -> Wave {
+    static auto load_from_memory(czstring file_type, std::span<const unsigned char> data) noexcept -> Wave {
         return {::LoadWaveFromMemory(file_type, data.data(), int(data.size()))};
     }
 
@@ -387,7 +544,7 @@ class Music: public ::Music {
   public:
     static auto load(czstring file_name) noexcept -> Music { return {::LoadMusicStream(file_name)}; }
 
-    static auto load_from_memory(czstring file_type, std::span<unsigned char> data) noexcept -> Music {
+    static auto load_from_memory(czstring file_type, std::span<const unsigned char> data) noexcept -> Music {
         return {::LoadMusicStreamFromMemory(file_type, data.data(), int(data.size()))};
     }
 
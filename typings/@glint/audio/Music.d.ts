@@ -7,6 +7,12 @@ export class Music {
      */
     constructor(path: string);
 
+    /**
+     * Load music in background: file is read on loader threads
+     * @param path Path to music file
+     */
+    static load(path: string): Promise<Music>;
+
     /**
      * Is music playing
      */
@@ -15,6 +15,12 @@ export class Sound {
      */
     constructor(path: string);
 
+    /**
+     * Load sound in background: file is read and decoded on loader threads
+     * @param path Path to sound file
+     */
+    static load(path: string): Promise<Sound>;
+
     /**
      * Is sound playing
      */
@@ -2,12 +2,17 @@ export * from "@glint/core/Camera";
 export * from "@glint/core/Color";
 export * from "@glint/core/Font";
 export * from "@glint/core/NPatch";
+export * from "@glint/core/ParticleEmitter";
 export * from "@glint/core/Rectangle";
 export * from "@glint/core/Text";
+export * from "@glint/core/TextLayout";
 export * from "@glint/core/Texture";
+export * from "@glint/core/TileMap";
 export * from "@glint/core/Vector2";
+export * from "@glint/core/Vector2Array";
 export * from "@glint/core/console";
 export * from "@glint/core/graphics";
 export * from "@glint/core/keyboard";
 export * from "@glint/core/mouse";
+export * from "@glint/core/profiler";
 export * from "@glint/core/screen";
@@ -5,6 +5,16 @@ export class Font {
 
     constructor(options: { path: string; name?: string; fontSize?: number; codepoints?: number[] });
 
+    /**
+     * Load font in background: TTF/OTF fonts are rasterized on loader threads,
+     * only the atlas upload happens on main thread.
+     */
+    static load(path: string): Promise<Font>;
+
+    static load(
+        options: { name: string } | { path: string; name?: string; fontSize?: number; codepoints?: number[] }
+    ): Promise<Font>;
+
     get valid(): boolean;
 }
 
@@ -0,0 +1,41 @@
+import { type Font } from "@glint/core/Font";
+
+/**
+ * String laid out against a font once. Glyph lookup, advances and line breaks are resolved when the
+ * layout is created or changed, so drawing it every frame costs one quad per glyph.
+ *
+ * @example
+ * ```js
+ * import { Color, TextLayout, graphics } from "@glint/core";
+ *
+ * const score = new TextLayout("Score: 0", 20);
+ *
+ * export function draw() {
+ *     graphics.textLayout(score, { x: 10, y: 10 }, new Color(255, 255, 255, 255));
+ * }
+ * ```
+ */
+export class TextLayout {
+    /**
+     * @param text UTF-8 text, `\n` starts a new line
+     * @param fontSize font size in pixels
+     * @param font font to lay out against, defaults to raylib's default font
+     * @param spacing extra space between glyphs, defaults to 0
+     */
+    constructor(text: string, fontSize: number, font?: Font, spacing?: number);
+
+    /** Changing the text lays it out again on next use */
+    text: string;
+    fontSize: number;
+    spacing: number;
+    readonly font: Font | undefined;
+
+    /** Size of the laid out text, same as raylib's `MeasureTextEx` */
+    readonly width: number;
+    readonly height: number;
+
+    /** Number of glyph quads drawn, whitespace excluded */
+    readonly glyphs: number;
+
+    toString(): string;
+}
@@ -29,6 +29,39 @@ export class Texture {
 
     constructor(options: { path: string; name?: string });
 
+    /**
+     * Load texture in background: file is read and decoded on loader threads,
+     * only the GPU upload happens on main thread.
+     *
+     * @example
+     * ```js
+     * const t = await Texture.load("sprite.png");
+     * ```
+     */
+    static load(path: string): Promise<Texture>;
+
+    static load(options: { name: string } | { path: string; name?: string }): Promise<Texture>;
+
+    /**
+     * Pack images into shared atlas pages. Textures created afterwards from these paths draw a
+     * region of a page, so draws of different images can be batched together. Images larger than
+     * a page stay separate textures. Paths packed already are skipped.
+     *
+     * Source rectangles passed to `graphics` are relative to the image, but must stay within it:
+     * outside of it the neighbouring images of the page are visible.
+     *
+     * @example
+     * ```js
+     * Texture.atlas(["player.png", "enemy.png", "coin.png"]);
+     * const player = new Texture("player.png");
+     * ```
+     *
+     * @param options.pageSize width and height of every page in pixels, defaults to 2048
+     * @param options.padding transparent pixels around every image, defaults to 1
+     * @returns number of new pages
+     */
+    static atlas(paths: string[], options?: { pageSize?: number; padding?: number }): number;
+
     /**
      * Check if a texture is valid (loaded in GPU)
      */
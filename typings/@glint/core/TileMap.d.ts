@@ -0,0 +1,80 @@
+import { type Camera } from "@glint/core/Camera";
+import { type Texture } from "@glint/core/Texture";
+
+/**
+ * Grid of tiles cut from one tileset texture. The map is split into square chunks that are
+ * rendered into cached textures, so drawing it costs one quad per visible chunk no matter how
+ * many tiles it has.
+ *
+ * @example
+ * ```js
+ * import { Camera, Texture, TileMap } from "@glint/core";
+ *
+ * const map = new TileMap(new Texture("tiles.png"), 1000, 1000, 16, 16);
+ * map.set(0, 0, 1).set(1, 0, 2);
+ *
+ * export function draw() {
+ *     map.draw(camera);
+ * }
+ * ```
+ */
+export class TileMap {
+    /**
+     * @param tileset texture with tiles laid out left to right, top to bottom
+     * @param columns number of tiles per row
+     * @param rows number of rows
+     * @param tileWidth tile width in pixels
+     * @param tileHeight tile height in pixels
+     * @param chunkSize tiles per chunk side, defaults to 32. Chunk textures are at most 4096px on
+     *     either side, so it is limited to `4096 / max(tileWidth, tileHeight)`
+     */
+    constructor(
+        tileset: Texture,
+        columns: number,
+        rows: number,
+        tileWidth: number,
+        tileHeight: number,
+        chunkSize?: number,
+    );
+
+    get columns(): number;
+    get rows(): number;
+    get tileWidth(): number;
+    get tileHeight(): number;
+    get chunkSize(): number;
+
+    /**
+     * Tile indices row by row: 0 is empty, `n` is tileset cell `n - 1`.
+     * Call {@link invalidate} after writing to it directly
+     */
+    get tiles(): Uint16Array;
+
+    /** Chunk textures kept in GPU memory, least recently drawn ones are freed first. Defaults to 64 */
+    maxCachedChunks: number;
+
+    /** Chunk textures currently in GPU memory */
+    get cachedChunks(): number;
+
+    /** Chunks drawn by the last {@link draw} */
+    get drawnChunks(): number;
+
+    /** Tile at column `x` and row `y`, 0 outside of the map */
+    get(x: number, y: number): number;
+
+    /** Sets tile at column `x` and row `y` */
+    set(x: number, y: number, tile: number): TileMap;
+
+    /**
+     * Marks chunks overlapping the given tile rectangle for redraw, or the whole map without arguments.
+     * Parts outside of the map are ignored, negative sizes throw `RangeError`
+     */
+    invalidate(x?: number, y?: number, width?: number, height?: number): TileMap;
+
+    /**
+     * Draws the chunks visible through `camera`, or on the screen without it. Call it outside of
+     * `beginCameraMode` and `beginTextureMode`: the map applies the camera itself
+     */
+    draw(camera?: Camera): TileMap;
+}
+
+export default TileMap;
@@ -0,0 +1,49 @@
+import { type BasicVector2, type Vector2 } from "@glint/core/Vector2";
+
+/**
+ * Fixed number of 2D vectors stored in one Float32Array as `[x0, y0, x1, y1, ...]`.
+ * Use it instead of many {@link Vector2} objects for bulk data like particle positions.
+ *
+ * @example
+ * ```js
+ * import { Vector2Array, screen } from "@glint/core";
+ *
+ * const positions = new Vector2Array(1000);
+ * const velocities = new Vector2Array(1000).fill(10, 0);
+ *
+ * export function update() {
+ *     positions.addScaled(velocities, screen.dt);
+ * }
+ * ```
+ */
+export class Vector2Array {
+    /**
+     * @param length Number of vectors, all initialized to zero
+     */
+    constructor(length: number);
+
+    /** Number of vectors */
+    get length(): number;
+
+    /** Underlying storage, vector `i` is at `data[i * 2]` and `data[i * 2 + 1]` */
+    get data(): Float32Array;
+
+    /**
+     * Copy vector at index
+     * @param out Vector to write into instead of creating a new one
+     */
+    get(index: number, out?: Vector2): Vector2;
+
+    /** Set vector at index */
+    set(index: number, x: number, y: number): Vector2Array;
+    set(index: number, v: BasicVector2): Vector2Array;
+
+    /** Set all vectors */
+    fill(x: number, y: number): Vector2Array;
+    fill(v: BasicVector2): Vector2Array;
+
+    /** Add `other[i] * scale` to every vector */
+    addScaled(other: Vector2Array, scale: number): Vector2Array;
+}
+
+export default Vector2Array;
@@ -1,6 +1,7 @@
 import { Camera } from "@glint/core/Camera";
 import { NPatch } from "@glint/core/NPatch";
 import { Text } from "@glint/core/Text";
+import { TextLayout } from "@glint/core/TextLayout";
 import { Texture } from "@glint/core/Texture";
 import { type BasicColor } from "@glint/core/Color";
 import { type BasicRectangle } from "@glint/core/Rectangle";
@@ -11,15 +12,39 @@ export interface Graphics {
 
     circle(x: number, y: number, radius: number, color: BasicColor): Graphics;
 
+    /**
+     * Draws many circles in a single call
+     *
+     * @param data circles packed as `[x, y, radius]` triples
+     * @param colors either packed `[r, g, b, a]` bytes for every circle or one color for all of them
+     */
+    circles(data: Float32Array, colors: Uint8Array | BasicColor): Graphics;
+
     rectangle(x: number, y: number, width: number, height: number, color: BasicColor): Graphics;
     rectangleV(position: BasicVector2, size: BasicVector2, color: BasicColor): Graphics;
     rectangleRec(rec: BasicRectangle, color: BasicColor): Graphics;
     rectanglePro(rec: BasicRectangle, origin: BasicVector2, rotation: number, color: BasicColor): Graphics;
 
+    /**
+     * Draws many rectangles in a single call
+     *
+     * @param data rectangles packed as `[x, y, width, height]` quadruples
+     * @param colors either packed `[r, g, b, a]` bytes for every rectangle or one color for all of them
+     */
+    rectangles(data: Float32Array, colors: Uint8Array | BasicColor): Graphics;
+
     beginCameraMode(camera: Camera): Graphics;
     endCameraMode(): Graphics;
 
     texture(texture: Texture, x: number, y: number, tint: BasicColor): Graphics;
+
+    /**
+     * Draws texture at many positions in a single call
+     *
+     * @param positions positions packed as `[x, y]` pairs
+     * @param tints either packed `[r, g, b, a]` bytes for every position or one tint for all of them
+     */
+    textures(texture: Texture, positions: Float32Array, tints: Uint8Array | BasicColor): Graphics;
     textureV(texture: Texture, position: BasicVector2, tint: BasicColor): Graphics;
     textureEx(texture: Texture, position: BasicVector2, rotation: number, scale: number, tint: BasicColor): Graphics;
     textureRec(texture: Texture, source: BasicRectangle, position: BasicVector2, tint: BasicColor): Graphics;
@@ -40,8 +65,79 @@ export interface Graphics {
         tint: BasicColor,
     ): Graphics;
 
+    /**
+     * Records a textured quad instead of drawing it right away. Recorded sprites are drawn on
+     * {@link flush}, camera or texture mode changes, {@link clear} and at the end of `draw`,
+     * sorted by layer, blend mode and texture, so that sprites sharing a texture are drawn together.
+     * Order of sprites with different textures within one layer is not preserved
+     *
+     * @param layer sprites of lower layers are drawn first, defaults to 0
+     */
+    sprite(
+        texture: Texture,
+        source: BasicRectangle,
+        dest: BasicRectangle,
+        tint?: BasicColor,
+        layer?: number,
+        rotation?: number,
+        origin?: BasicVector2,
+    ): Graphics;
+
+    /** Draws sprites recorded so far */
+    flush(): Graphics;
+
+    /** Blend mode of sprites recorded from now on, one of raylib `BlendMode` values. Defaults to alpha blending */
+    blendMode: number;
+
+    /** Sprite batching counters of the last frame */
+    readonly spriteStats: {
+        sprites: number;
+        drawCalls: number;
+        textureSwitches: number;
+    };
+
+    /**
+     * Skip draws outside of the camera view while in camera mode. Enabled by default.
+     * Draw calls still return immediately, so culled draws cost only a bounds check
+     */
+    culling: boolean;
+
+    /** Culling counters of the last frame */
+    readonly cullStats: {
+        /** Draws passed on to the renderer */
+        submitted: number;
+        /** Draws skipped for being outside of the camera view */
+        culled: number;
+    };
+
     text(text: string, x: number, y: number, fontSize: number, color: BasicColor): Graphics;
     textPro(text: Text): Graphics;
+
+    /**
+     * Draws a prepared text layout
+     *
+     * @param position top left corner of the text, and the pivot of rotation
+     * @param rotation in degrees, defaults to 0
+     * @param origin offset of the text's top left corner from `position`, defaults to `{ x: 0, y: 0 }`
+     */
+    textLayout(
+        layout: TextLayout,
+        position: BasicVector2,
+        color: BasicColor,
+        rotation?: number,
+        origin?: BasicVector2,
+    ): Graphics;
+
+    /**
+     * Glyph run cache counters of the last frame. `text` and `textPro` lay out each distinct string
+     * once and redraw it from the cache while it stays unchanged
+     */
+    readonly textCacheStats: {
+        hits: number;
+        misses: number;
+        /** Runs currently cached */
+        runs: number;
+    };
 }
 
 export declare const graphics: Graphics;
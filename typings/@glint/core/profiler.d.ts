@@ -0,0 +1,46 @@
+/** Rolling timings of one frame phase in milliseconds */
+export interface PhaseStats {
+    /** Duration during the last completed frame */
+    last: number;
+    p50: number;
+    p95: number;
+    p99: number;
+    max: number;
+}
+
+/** Number of native objects behind JS instances of one class */
+export interface InstanceStats {
+    /** Instances not yet garbage collected */
+    live: number;
+    /** Highest number of live instances so far */
+    peak: number;
+    /** Whether instances are allocated from a reusable pool */
+    pooled: boolean;
+}
+
+/**
+ * @inline
+ */
+export interface Profiler {
+    /** Whether frame phases are measured */
+    enabled: boolean;
+
+    /** Whether the timing overlay is drawn in the top right corner */
+    overlay: boolean;
+
+    /**
+     * Returns timings of every phase over the last 240 frames.
+     *
+     * Phases are `frame`, `update:<plugin>`, `update:game`, `draw:<plugin>`, `draw:game` and `present`.
+     * `present` includes buffer swap, input polling and the frame limiter wait.
+     */
+    stats(): Record<string, PhaseStats>;
+
+    /**
+     * Returns instance counts of every native class (`Vector2`, `Color`, `Texture`, ...) created so far
+     */
+    instances(): Record<string, InstanceStats>;
+}
+
+export declare const profiler: Profiler;
+export default profiler;
@@ -2,9 +2,18 @@
  * @inline
  */
 export interface Screen {
-    /** Time since last frame in seconds */
+    /** Time since last frame in seconds, or the fixed step inside `fixedUpdate` */
     get dt(): number;
 
+    /** Seconds per `fixedUpdate` call, zero when `config.loop.fixedUpdateHz` is not set */
+    get fixedDt(): number;
+
+    /**
+     * Fraction of the next `fixedUpdate` step already elapsed, from 0 to 1. Use it in `draw`
+     * to interpolate between previous and current simulation state
+     */
+    get alpha(): number;
+
     /** Time since window initialization */
     get time(): number;
 
@@ -0,0 +1,114 @@
+import { type BasicColor } from "@glint/core/Color";
+
+/** Numeric type of a component field, named after typed arrays */
+export type FieldType = "f32" | "f64" | "i8" | "u8" | "i16" | "u16" | "i32" | "u32";
+
+/** Component id returned by `World.component` */
+export type ComponentId = number;
+
+/** Entity handle. Handles of destroyed entities are never alive again */
+export type Entity = number;
+
+/** Columns of one component in a chunk: a typed array per field */
+export type ComponentColumns = Record<string, Float32Array | Float64Array | Int8Array | Uint8Array | Int16Array
+    | Uint16Array | Int32Array | Uint32Array>;
+
+/** Entities of one archetype matching a query, stored contiguously */
+export interface Chunk {
+    count: number;
+    entities: Uint32Array;
+    /** Columns of the queried components, in query order */
+    columns: ComponentColumns[];
+    /** Columns by component name */
+    [component: string]: unknown;
+}
+
+/**
+ * Entities having a set of components. Chunks are rebuilt only after the world changes structurally:
+ * creating or destroying entities, or adding or removing components. Typed arrays of earlier chunks
+ * are detached by such changes, so read `chunks` again after making them.
+ */
+export class Query {
+    private constructor();
+
+    readonly chunks: Chunk[];
+    /** Entities matching the query */
+    readonly count: number;
+
+    toString(): string;
+}
+
+/**
+ * Entities with components of fixed numeric layout, stored natively by archetype with one contiguous
+ * column per field. Systems iterate the columns through typed arrays, and built-in native systems run
+ * over them without calling into JS per entity.
+ *
+ * @example
+ * ```js
+ * import { World } from "@glint/ecs";
+ * import { Color } from "@glint/core";
+ *
+ * const world = new World();
+ * const Position = world.component("position", { x: "f32", y: "f32" });
+ * const Velocity = world.component("velocity", { x: "f32", y: "f32" });
+ * const Size = world.component("size", { w: "f32", h: "f32" });
+ *
+ * const e = world.create([Position, Velocity, Size]);
+ * world.set(e, Velocity, { x: 10, y: 0 }).set(e, Size, { w: 8, h: 8 });
+ *
+ * const moving = world.query([Position, Velocity]);
+ *
+ * export function update() {
+ *     for (const { count, position, velocity } of moving.chunks) {
+ *         for (let i = 0; i < count; i++) velocity.y[i] += 1;
+ *     }
+ *     world.move(Position, Velocity);
+ * }
+ *
+ * export function draw() {
+ *     world.drawRectangles(Position, Size, new Color(255, 255, 255, 255));
+ * }
+ * ```
+ */
+export class World {
+    constructor();
+
+    /** Entities alive */
+    readonly count: number;
+
+    /** Defines a component with fields in the order of `layout`. A world has at most 64 components */
+    component(name: string, layout: Record<string, FieldType>): ComponentId;
+
+    /** Creates an entity with zeroed `components` */
+    create(components?: ComponentId[]): Entity;
+    destroy(entity: Entity): World;
+    alive(entity: Entity): boolean;
+
+    has(entity: Entity, component: ComponentId): boolean;
+    /** Adds `component`, setting fields present in `values` and zeroing the rest */
+    add(entity: Entity, component: ComponentId, values?: Record<string, number>): World;
+    remove(entity: Entity, component: ComponentId): World;
+
+    /** Copy of component values */
+    get(entity: Entity, component: ComponentId): Record<string, number>;
+    /** Sets fields present in `values` */
+    set(entity: Entity, component: ComponentId, values: Record<string, number>): World;
+
+    query(components: ComponentId[]): Query;
+
+    /**
+     * Native movement system: adds `velocity * dt` to `position` of every entity having both.
+     * Both components must start with two `f32` fields.
+     *
+     * @param dt seconds, defaults to frame time
+     */
+    move(position: ComponentId, velocity: ComponentId, dt?: number): World;
+
+    /**
+     * Native rendering system: draws a rectangle for every entity having `position` and `size`,
+     * skipping ones outside of the camera view. Both components must start with two `f32` fields.
+     */
+    drawRectangles(position: ComponentId, size: ComponentId, color: BasicColor): World;
+
+    toString(): string;
+}
@@ -0,0 +1,73 @@
+import { type Console } from "@glint/core/console";
+
+export interface MessageEvent<T = unknown> {
+    data: T;
+}
+
+export interface ErrorEvent {
+    /** Message and stack of the error thrown inside the worker */
+    message: string;
+}
+
+/**
+ * Globals of a worker module, reachable through `self`. Workers have no `@glint/*` modules, so they compute
+ * and send results back to the game to draw.
+ */
+export interface WorkerGlobalScope {
+    readonly self: WorkerGlobalScope;
+    readonly console: Console;
+    /** Called for every message posted by the game */
+    onmessage: ((event: MessageEvent) => void) | null;
+    /** Sends a structured clone of `data` to the game. ArrayBuffers in `transfer` are detached afterwards */
+    postMessage(data: unknown, transfer?: ArrayBuffer[]): void;
+    /** Stops the worker once the current message is handled */
+    close(): void;
+}
+
+/**
+ * Runs a game module on a background thread, in its own JS runtime, so long computations like AI or procedural
+ * generation do not stall rendering. Modules are loaded from the game files like the game module itself.
+ *
+ * Messages are structured clones: objects, arrays, typed arrays and maps are copied, functions are not allowed.
+ * A `SharedArrayBuffer` is shared without copying, and `Atomics` synchronize access to it. Only workers may
+ * block in `Atomics.wait`.
+ *
+ * Handlers are called at the start of a frame, before `update`. A running worker is kept alive even when the
+ * game keeps no reference to it.
+ *
+ * @example
+ * ```js
+ * // game.js
+ * import { Worker } from "@glint/worker";
+ *
+ * const shared = new Int32Array(new SharedArrayBuffer(4));
+ * const worker = new Worker("pathfinder.js");
+ * worker.onmessage = (e) => console.log("path", e.data);
+ * worker.postMessage({ from: [0, 0], to: [10, 4], progress: shared });
+ *
+ * // pathfinder.js
+ * onmessage = (e) => {
+ *     Atomics.store(e.data.progress, 0, 100);
+ *     postMessage(findPath(e.data.from, e.data.to));
+ * };
+ * ```
+ */
+export class Worker {
+    /** @param path module path relative to the game root, `.js` is appended when it has no extension */
+    constructor(path: string);
+
+    /** False once the worker was terminated, closed itself or failed to load */
+    readonly running: boolean;
+
+    onmessage: ((event: MessageEvent) => void) | null;
+    /** Called with uncaught errors of the worker. Without a handler they are logged */
+    onerror: ((event: ErrorEvent) => void) | null;
+
+    /** Sends a structured clone of `data` to the worker. ArrayBuffers in `transfer` are detached afterwards */
+    postMessage(data: unknown, transfer?: ArrayBuffer[]): void;
+
+    /** Stops the worker, interrupting the script it runs. Messages not yet handled are dropped */
+    terminate(): void;
+
+    toString(): string;
+}
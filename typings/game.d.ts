@@ -104,6 +104,28 @@ export interface Config {
          */
         interlaced?: boolean;
     };
+
+    loader?: {
+        /**
+         * Maximum number of background loads (e.g. `Texture.load`) finished on main thread per frame,
+         * defaults to 4
+         */
+        uploadsPerFrame?: number;
+    };
+
+    loop?: {
+        /**
+         * Rate of {@link fixedUpdate} calls per second, independent of frame rate.
+         * Fixed updates are disabled when not set
+         */
+        fixedUpdateHz?: number;
+
+        /**
+         * Maximum number of {@link fixedUpdate} calls per frame. Time beyond that is dropped
+         * so a slow frame does not cause even more work in the next one, defaults to 5
+         */
+        maxFixedUpdates?: number;
+    };
 }
 
 /**
@@ -128,6 +150,15 @@ export function load(): void;
  */
 export function update(): void;
 
+/**
+ * Called zero or more times per frame, before {@link update}, at the rate set by
+ * `config.loop.fixedUpdateHz`. `screen.dt` equals the fixed step inside it
+ *
+ * @event
+ * @optional
+ */
+export function fixedUpdate(): void;
+
 /**
  * Called every frame when engine draws game
  *
@@ -140,6 +171,11 @@ export function draw(): void;
  * Called before game reloading. This function returns JS value that later will
  * be passed to {@link postReload}
  *
+ * Reloaded game runs in a fresh context, so the value is copied over: it may hold
+ * primitives, plain objects, arrays and typed arrays, but not functions or engine
+ * objects. Class instances arrive as plain objects. If the value cannot be copied, the error
+ * is logged and {@link postReload} is called without it
+ *
  * @event
  * @optional
  */
@@ -6,6 +6,7 @@ add_requires("boost 1.90.0")
 add_requires("fmt", { configs = { header_only = false } })
 add_requires("libzip v1.11.4")
 add_requires("microsoft-gsl v4.2.1")
+add_requires("nanobench v4.3.11")
 add_requires("quickjs-ng v0.11.0", { alias = "quickjs", configs = { debug = true } })
 add_requires("raylib 5.5")
 add_requires("spdlog 1.16.0", { configs = { header_only = false, fmt_external = true } })
@@ -28,8 +29,11 @@ target("glint", function()
 		"src/error.cpp",
 		"src/file_store.cpp",
 		"src/main.cpp",
+		"src/pack.cpp",
 		"src/plugins/core.cpp",
-		"src/plugins/audio.cpp"
+		"src/plugins/audio.cpp",
+		"src/plugins/ecs.cpp",
+		"src/plugins/worker.cpp"
 	)
 	add_files("src/**.js")
 
@@ -51,6 +55,33 @@ target("glint", function()
 	add_rules("utils.bin2c", { extensions = ".js" })
 end)
 
+target("glint-bench", function()
+	set_kind("binary")
+	set_default(false)
+	add_packages({ "quickjs", "fmt", "libzip", "spdlog", "raylib", "microsoft-gsl", "boost", "nanobench" })
+
+	add_files(
+		"bench/*.cpp",
+		"src/engine.cpp",
+		"src/error.cpp",
+		"src/file_store.cpp",
+		"src/plugins/core.cpp",
+		"src/plugins/ecs.cpp"
+	)
+	add_files("src/**.js")
+
+	add_includedirs("src")
+
+	add_defines("SPDLOG_COMPILED_LIB")
+	add_defines("SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_TRACE")
+
+	set_configdir("$(builddir)/config")
+	add_configfiles("src/config.h.in", { filename = "glint_config.h" })
+	add_includedirs("$(builddir)/config")
+
+	add_rules("utils.bin2c", { extensions = ".js" })
+end)
+
 --
 -- If you want to known more usage about xmake, please see https://xmake.io
 --